@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Core/Rope.h"
+#include "Core/String.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    const std::string& GetDocument(std::size_t size)
+    {
+        static std::string document;
+        if (document.size() != size)
+        {
+            document.assign(size, 'x');
+            for (std::size_t i = 80; i < size; i += 81)
+            {
+                document[i] = '\n';
+            }
+        }
+        return document;
+    }
+} // namespace
+
+// an editor buffer: small inserts into the middle of a large text
+static void BM_StringMiddleInsert(benchmark::State& state)
+{
+    Core::StringAtom text(std::string_view(GetDocument(static_cast<std::size_t>(state.range(0)))));
+    for (auto _ : state)
+    {
+        text.Insert(static_cast<long long>(text.Size() / 2), "edit", 4);
+        benchmark::DoNotOptimize(text.CStr());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_RopeMiddleInsert(benchmark::State& state)
+{
+    Core::StringRope text(std::string_view(GetDocument(static_cast<std::size_t>(state.range(0)))));
+    for (auto _ : state)
+    {
+        text.Insert(text.Size() / 2, "edit");
+        benchmark::DoNotOptimize(text.Size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_StringSubStr(benchmark::State& state)
+{
+    const Core::StringAtom text(std::string_view(GetDocument(static_cast<std::size_t>(state.range(0)))));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Core::StringAtom(text.ToStringView().substr(text.Size() / 4, text.Size() / 2)));
+    }
+}
+
+static void BM_RopeSubRope(benchmark::State& state)
+{
+    const Core::StringRope text(std::string_view(GetDocument(static_cast<std::size_t>(state.range(0)))));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(text.SubRope(text.Size() / 4, text.Size() / 2));
+    }
+}
+
+BENCHMARK(BM_StringMiddleInsert)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_RopeMiddleInsert)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_StringSubStr)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_RopeSubRope)->Arg(1 << 16)->Arg(1 << 20);
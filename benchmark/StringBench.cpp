@@ -20,9 +20,18 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include "AllocationCounter.h"
+#include "Core/MultiMatcher.h"
 #include "Core/String.h"
+#include "Core/StringView.h"
 
+#include <algorithm>
 #include <benchmark/benchmark.h>
+#include <cctype>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+#include <vector>
 
 static void BM_StdString(benchmark::State& state)
 {
@@ -107,6 +116,541 @@ static void BM_PushBack(benchmark::State& state)
     }
 }
 
+static void BM_StdStringAppend(benchmark::State& state)
+{
+    std::string str;
+    for (auto _ : state)
+    {
+        str += "Hello";
+    }
+}
+
+static void BM_Append(benchmark::State& state)
+{
+    Core::StringAtom str;
+    for (auto _ : state)
+    {
+        str += "Hello";
+    }
+}
+
+static const char* hashedText =
+    "Lorem Ipsum is simply dummy text of the printing and typesetting industry. Lorem Ipsum has been the industry's standard dummy text ever since the 1500s";
+
+static void BM_StdStringHash(benchmark::State& state)
+{
+    const std::string str = hashedText;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::hash<std::string>{}(str));
+    }
+}
+
+static void BM_DynamicHash(benchmark::State& state)
+{
+    const Core::StringAtom str = hashedText;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::hash<Core::StringAtom>{}(str));
+    }
+}
+
+static void BM_AtomHash(benchmark::State& state)
+{
+    const auto str = Core::StringAtom::Intern(hashedText);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::hash<Core::StringAtom>{}(str));
+    }
+}
+
+// short keys fit into the inline buffers of both strings
+static const char* shortKeys[] = { "id", "user", "session", "timestamp", "level", "message", "host", "request_id" };
+
+static void BM_StdStringShortKeyConstruct(benchmark::State& state)
+{
+    std::size_t index = 0;
+    Bench::AllocationCounter::Start();
+    for (auto _ : state)
+    {
+        std::string key = shortKeys[index++ % std::size(shortKeys)];
+        benchmark::DoNotOptimize(key.data());
+    }
+    state.counters["AllocsPerKey"] = static_cast<double>(Bench::AllocationCounter::Stop().allocationsCount) / state.iterations();
+}
+
+static void BM_ShortKeyConstruct(benchmark::State& state)
+{
+    std::size_t index = 0;
+    Bench::AllocationCounter::Start();
+    for (auto _ : state)
+    {
+        Core::StringAtom key = shortKeys[index++ % std::size(shortKeys)];
+        benchmark::DoNotOptimize(key.c_str());
+    }
+    state.counters["AllocsPerKey"] = static_cast<double>(Bench::AllocationCounter::Stop().allocationsCount) / state.iterations();
+}
+
+static void BM_StdStringShortKeyCopy(benchmark::State& state)
+{
+    const std::string key = "session";
+    for (auto _ : state)
+    {
+        std::string copy = key;
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+static void BM_ShortKeyCopy(benchmark::State& state)
+{
+    const Core::StringAtom key = "session";
+    for (auto _ : state)
+    {
+        Core::StringAtom copy = key;
+        benchmark::DoNotOptimize(copy.c_str());
+    }
+}
+
+// a string passed by value into a container, CORE_STRING_COPY_ON_WRITE makes the copy share the buffer
+static void BM_StdStringLongCopy(benchmark::State& state)
+{
+    const std::string value(64, 'v');
+    Bench::AllocationCounter::Start();
+    for (auto _ : state)
+    {
+        std::string copy = value;
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.counters["AllocsPerCopy"] = static_cast<double>(Bench::AllocationCounter::Stop().allocationsCount) / state.iterations();
+}
+
+static void BM_LongCopy(benchmark::State& state)
+{
+    const Core::StringAtom value(std::string(64, 'v'));
+    Bench::AllocationCounter::Start();
+    for (auto _ : state)
+    {
+        Core::StringAtom copy = value;
+        benchmark::DoNotOptimize(copy.c_str());
+    }
+    state.counters["AllocsPerCopy"] = static_cast<double>(Bench::AllocationCounter::Stop().allocationsCount) / state.iterations();
+}
+
+// tokenizing a config line: the atoms allocate a copy per token, the views point into the line
+static void BM_SplitAtoms(benchmark::State& state)
+{
+    const Core::StringAtom line = "upstream_server_address = backend.internal.example.com ; connection_timeout_ms = 30000";
+    Bench::AllocationCounter::Start();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(line.Split(" =;"));
+    }
+    state.counters["AllocsPerLine"] = static_cast<double>(Bench::AllocationCounter::Stop().allocationsCount) / state.iterations();
+}
+
+static void BM_SplitViews(benchmark::State& state)
+{
+    const Core::StringAtom line = "upstream_server_address = backend.internal.example.com ; connection_timeout_ms = 30000";
+    Bench::AllocationCounter::Start();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Core::StringAtomView(line).Split(" =;"));
+    }
+    state.counters["AllocsPerLine"] = static_cast<double>(Bench::AllocationCounter::Stop().allocationsCount) / state.iterations();
+}
+
+namespace
+{
+    const Core::StringAtom& GetLog()
+    {
+        static const Core::StringAtom log = []() {
+            Core::StringAtom result;
+            for (int i = 0; result.Size() < (1 << 20); ++i)
+            {
+                result += Core::StrCat("2024-01-01 12:00:00 INFO request ", i, " served in 12 ms\n");
+            }
+            return result;
+        }();
+        return log;
+    }
+} // namespace
+
+static void BM_SplitLogLines(benchmark::State& state)
+{
+    const auto& log = GetLog();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(log.Split("\n").size());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * log.Size()));
+}
+
+static void BM_SplitViewLogLines(benchmark::State& state)
+{
+    const auto& log = GetLog();
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+        for (const auto line : Core::SplitView(log, "\n"))
+        {
+            count += line.Size();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * log.Size()));
+}
+
+// a needle near the end of a 4 MiB text: the search is bound by the memory bandwidth
+static const Core::StringAtom& GetHaystack()
+{
+    static const Core::StringAtom haystack = []() {
+        std::string text;
+        while (text.size() < (4 << 20))
+        {
+            text += "GET /api/v1/items?page=1 HTTP/1.1 200 OK - user-agent: bench/1.0\n";
+        }
+        text += "needle-request-id";
+        return Core::StringAtom(std::string_view(text));
+    }();
+    return haystack;
+}
+
+static void BM_StrStrFind(benchmark::State& state)
+{
+    const auto& haystack = GetHaystack();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::strstr(haystack.c_str(), "needle-request-id"));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * haystack.Size()));
+}
+
+static void BM_Find(benchmark::State& state)
+{
+    const auto& haystack = GetHaystack();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(haystack.Find("needle-request-id"));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * haystack.Size()));
+}
+
+static void BM_FindAll(benchmark::State& state)
+{
+    const auto& haystack = GetHaystack();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(haystack.FindAllOffsets("HTTP/1.1").size());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * haystack.Size()));
+}
+
+// two hundred keywords which don't occur in the log lines
+static const std::vector<std::string>& GetKeywords()
+{
+    static const std::vector<std::string> keywords = []() {
+        std::vector<std::string> result;
+        for (int i = 0; i < 200; ++i)
+        {
+            result.push_back("keyword-" + std::to_string(i * 7919));
+        }
+        return result;
+    }();
+    return keywords;
+}
+
+static void BM_FindKeywordsLoop(benchmark::State& state)
+{
+    const Core::StringAtom haystack{ std::string_view(GetHaystack().c_str(), 1 << 16) };
+    for (auto _ : state)
+    {
+        int count = 0;
+        for (const auto& keyword : GetKeywords())
+        {
+            count += haystack.Find(keyword) != nullptr;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * haystack.Size()));
+}
+
+static void BM_MultiMatcher(benchmark::State& state)
+{
+    const Core::StringAtom haystack{ std::string_view(GetHaystack().c_str(), 1 << 16) };
+    const Core::StringMultiMatcher matcher(GetKeywords());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(matcher.FindAll(haystack).size());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * haystack.Size()));
+}
+
+// request headers: lowercased and then looked up by a key which may come in any case
+static const std::string& GetHeaders()
+{
+    static const std::string headers = []() {
+        std::string result;
+        for (int i = 0; i < 64; ++i)
+        {
+            result += "Content-Type: text/html; charset=UTF-8\r\nAccept-Encoding: gzip, deflate, br\r\n";
+        }
+        return result;
+    }();
+    return headers;
+}
+
+static void BM_StdStringToLower(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::string text = GetHeaders();
+        for (auto& ch : text)
+        {
+            ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        }
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * GetHeaders().size()));
+}
+
+static void BM_ToLowerCase(benchmark::State& state)
+{
+    const Core::StringAtom source{ std::string_view(GetHeaders()) };
+    for (auto _ : state)
+    {
+        auto text = source;
+        text.ToLowerCase();
+        benchmark::DoNotOptimize(text.c_str());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * source.Size()));
+}
+
+static void BM_StrCaseCmp(benchmark::State& state)
+{
+    std::string lower = GetHeaders();
+    std::ranges::transform(lower, lower.begin(), [](char ch) { return static_cast<char>(std::tolower(static_cast<unsigned char>(ch))); });
+    for (auto _ : state)
+    {
+        const auto equal = std::ranges::equal(GetHeaders(), lower, [](char first, char second) {
+            return std::toupper(static_cast<unsigned char>(first)) == std::toupper(static_cast<unsigned char>(second));
+        });
+        benchmark::DoNotOptimize(equal);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * lower.size()));
+}
+
+static void BM_IsEqualIgnoreCase(benchmark::State& state)
+{
+    const Core::StringAtom source{ std::string_view(GetHeaders()) };
+    auto lower = source;
+    lower.ToLowerCase();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(source.IsEqualIgnoreCase(lower));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * source.Size()));
+}
+
+// keys with a long common prefix, so a comparison has to look past the first vector
+static std::vector<std::string> MakeSortKeys()
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i < 4096; ++i)
+    {
+        keys.push_back("/api/v1/organizations/default/projects/" + std::to_string(i * 7919 % 4096));
+    }
+    return keys;
+}
+
+static void BM_StdStringSort(benchmark::State& state)
+{
+    const auto keys = MakeSortKeys();
+    for (auto _ : state)
+    {
+        auto sorted = keys;
+        std::ranges::sort(sorted);
+        benchmark::DoNotOptimize(sorted.data());
+    }
+}
+
+static void BM_Sort(benchmark::State& state)
+{
+    std::vector<Core::StringAtom> keys;
+    for (const auto& key : MakeSortKeys())
+    {
+        keys.emplace_back(std::string_view(key));
+    }
+    for (auto _ : state)
+    {
+        auto sorted = keys;
+        std::ranges::sort(sorted);
+        benchmark::DoNotOptimize(sorted.data());
+    }
+}
+
+static void BM_DynamicEqual(benchmark::State& state)
+{
+    const auto keys = MakeSortKeys();
+    const Core::StringAtom first{ std::string_view(keys[0]) };
+    const Core::StringAtom second{ std::string_view(keys[1]) };
+    const Core::StringAtom copy{ std::string_view(keys[0]) };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(first == second);
+        benchmark::DoNotOptimize(first == copy);
+    }
+}
+
+// a template with a thousand placeholders
+static std::string MakeTemplate()
+{
+    std::string text;
+    for (int i = 0; i < 1000; ++i)
+    {
+        text += "<li class=\"item\">{{name}} & {{value}}</li>\n";
+    }
+    return text;
+}
+
+static void BM_StdStringReplaceAll(benchmark::State& state)
+{
+    const std::string source = MakeTemplate();
+    const std::string_view from = "{{name}}";
+    const std::string_view to = "benchmark";
+    for (auto _ : state)
+    {
+        std::string text = source;
+        for (auto offset = text.find(from); offset != std::string::npos; offset = text.find(from, offset + to.size()))
+        {
+            text.replace(offset, from.size(), to);
+        }
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+
+static void BM_ReplaceAll(benchmark::State& state)
+{
+    const Core::StringAtom source = Core::StringAtom(std::string_view(MakeTemplate()));
+    for (auto _ : state)
+    {
+        auto text = source;
+        text.ReplaceAll("{{name}}", "benchmark");
+        benchmark::DoNotOptimize(text.c_str());
+    }
+}
+
+static void BM_StdStringReplaceMany(benchmark::State& state)
+{
+    const std::string source = MakeTemplate();
+    const std::pair<std::string_view, std::string_view> replacements[] = {
+        { "&", "&amp;" }, { "<", "&lt;" }, { ">", "&gt;" }, { "\"", "&quot;" }
+    };
+    for (auto _ : state)
+    {
+        std::string text = source;
+        for (const auto& [from, to] : replacements)
+        {
+            for (auto offset = text.find(from); offset != std::string::npos; offset = text.find(from, offset + to.size()))
+            {
+                text.replace(offset, from.size(), to);
+            }
+        }
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+
+static void BM_ReplaceMany(benchmark::State& state)
+{
+    const Core::StringAtom source = Core::StringAtom(std::string_view(MakeTemplate()));
+    for (auto _ : state)
+    {
+        auto text = source;
+        text.ReplaceMany({ { "&", "&amp;" }, { "<", "&lt;" }, { ">", "&gt;" }, { "\"", "&quot;" } });
+        benchmark::DoNotOptimize(text.c_str());
+    }
+}
+
+static void BM_StdStringShortKeyAppend(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::string key = "key_";
+        key += "42";
+        key.push_back('7');
+        benchmark::DoNotOptimize(key.data());
+    }
+}
+
+static void BM_ShortKeyAppend(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        Core::StringAtom key = "key_";
+        key += "42";
+        key.PushBack('7');
+        benchmark::DoNotOptimize(key.c_str());
+    }
+}
+
+// per-request strings: a few long fields which are built and thrown away together
+static void BM_RequestStrings(benchmark::State& state)
+{
+    Bench::AllocationCounter::Start();
+    for (auto _ : state)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            Core::StringAtom field = hashedText;
+            field += hashedText;
+            benchmark::DoNotOptimize(field.c_str());
+        }
+    }
+    state.counters["AllocsPerRequest"] = static_cast<double>(Bench::AllocationCounter::Stop().allocationsCount) / state.iterations();
+}
+
+static void BM_RequestStringsMonotonic(benchmark::State& state)
+{
+    char buffer[16 * 1024];
+    Bench::AllocationCounter::Start();
+    for (auto _ : state)
+    {
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+        for (int i = 0; i < 16; ++i)
+        {
+            Core::StringAtom field(hashedText, &arena);
+            field += hashedText;
+            benchmark::DoNotOptimize(field.c_str());
+        }
+    }
+    state.counters["AllocsPerRequest"] = static_cast<double>(Bench::AllocationCounter::Stop().allocationsCount) / state.iterations();
+}
+
+static void BM_LogLineAppend(benchmark::State& state)
+{
+    const auto level = Core::StringAtom::Intern("INFO");
+    for (auto _ : state)
+    {
+        Core::StringAtom line = "[";
+        line += level;
+        line += "] request_id=";
+        line += Core::StringAtom::MakeFrom(static_cast<int>(state.iterations()));
+        line += " path=/api/v1/users/profile status=200 message=";
+        line += hashedText;
+        benchmark::DoNotOptimize(line.c_str());
+    }
+}
+
+static void BM_LogLineStrCat(benchmark::State& state)
+{
+    const auto level = Core::StringAtom::Intern("INFO");
+    for (auto _ : state)
+    {
+        const auto line = Core::StrCat("[", level, "] request_id=", static_cast<int>(state.iterations()),
+                                       " path=/api/v1/users/profile status=200 message=", hashedText);
+        benchmark::DoNotOptimize(line.c_str());
+    }
+}
+
 BENCHMARK(BM_StdString);
 BENCHMARK(BM_StdStringLong);
 BENCHMARK(BM_StdStringConst);
@@ -114,5 +658,42 @@ BENCHMARK(BM_CString);
 BENCHMARK(BM_CStringAddr);
 BENCHMARK(BM_StdStringPushBack);
 BENCHMARK(BM_PushBack);
+BENCHMARK(BM_StdStringAppend);
+BENCHMARK(BM_Append);
+BENCHMARK(BM_StdStringHash);
+BENCHMARK(BM_DynamicHash);
+BENCHMARK(BM_AtomHash);
+BENCHMARK(BM_StdStringShortKeyConstruct);
+BENCHMARK(BM_ShortKeyConstruct);
+BENCHMARK(BM_StdStringShortKeyCopy);
+BENCHMARK(BM_ShortKeyCopy);
+BENCHMARK(BM_StdStringLongCopy);
+BENCHMARK(BM_LongCopy);
+BENCHMARK(BM_SplitAtoms);
+BENCHMARK(BM_SplitViews);
+BENCHMARK(BM_SplitLogLines);
+BENCHMARK(BM_SplitViewLogLines);
+BENCHMARK(BM_StrStrFind);
+BENCHMARK(BM_Find);
+BENCHMARK(BM_FindAll);
+BENCHMARK(BM_FindKeywordsLoop);
+BENCHMARK(BM_MultiMatcher);
+BENCHMARK(BM_StdStringToLower);
+BENCHMARK(BM_ToLowerCase);
+BENCHMARK(BM_StrCaseCmp);
+BENCHMARK(BM_IsEqualIgnoreCase);
+BENCHMARK(BM_StdStringSort);
+BENCHMARK(BM_Sort);
+BENCHMARK(BM_DynamicEqual);
+BENCHMARK(BM_StdStringReplaceAll);
+BENCHMARK(BM_ReplaceAll);
+BENCHMARK(BM_StdStringReplaceMany);
+BENCHMARK(BM_ReplaceMany);
+BENCHMARK(BM_StdStringShortKeyAppend);
+BENCHMARK(BM_ShortKeyAppend);
+BENCHMARK(BM_RequestStrings);
+BENCHMARK(BM_RequestStringsMonotonic);
+BENCHMARK(BM_LogLineAppend);
+BENCHMARK(BM_LogLineStrCat);
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,338 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "AllocationCounter.h"
+#include "Core/String.h"
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    constexpr int keysCount = 1 << 14;
+    constexpr int insertsPerThread = 1 << 16;
+
+    std::vector<std::string> MakeKeys(const std::string& prefix, int count)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            keys.push_back(prefix + std::to_string(i));
+        }
+        return keys;
+    }
+
+    const std::vector<std::string>& GetInternedKeys()
+    {
+        static const std::vector<std::string> keys = []() {
+            auto result = MakeKeys("service.metrics.requests.key_", keysCount);
+            for (const auto& key : result)
+            {
+                benchmark::DoNotOptimize(Core::StringAtom::Intern(key));
+            }
+            return result;
+        }();
+        return keys;
+    }
+
+    std::unique_ptr<Core::_StringPool<char>> insertPool;
+
+    Core::_StringPool<char>& GetHotKeysPool(bool isThreadCacheEnabled)
+    {
+        static Core::_StringPool<char> pools[2];
+        static const bool isInitialized = []() {
+            pools[1].SetThreadCacheEnabled(true);
+            return true;
+        }();
+        (void)isInitialized;
+        return pools[isThreadCacheEnabled ? 1 : 0];
+    }
+} // namespace
+
+static void BM_PoolLookupConcurrent(benchmark::State& state)
+{
+    const auto& keys = GetInternedKeys();
+    std::size_t index = static_cast<std::size_t>(state.thread_index()) * 7919;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Core::StringAtom::Intern(keys[index++ % keys.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// a hot set of keys which a request-parsing thread interns again and again
+static void BM_PoolLookupHotKeysConcurrent(benchmark::State& state)
+{
+    const auto& keys = GetInternedKeys();
+    const std::size_t hotKeysCount = static_cast<std::size_t>(state.range(0));
+    auto& pool = GetHotKeysPool(state.range(1) != 0);
+
+    Core::_StringPool<char>::ResetThreadCacheStatistics();
+    std::size_t index = static_cast<std::size_t>(state.thread_index()) * 7919;
+    for (auto _ : state)
+    {
+        const auto& key = keys[index++ % hotKeysCount];
+        benchmark::DoNotOptimize(pool.Add(key.data(), key.size()));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    const auto statistics = Core::_StringPool<char>::GetThreadCacheStatistics();
+    const auto lookupsCount = statistics.hitsCount + statistics.missesCount;
+    state.counters["HitRate"] = benchmark::Counter(lookupsCount ? static_cast<double>(statistics.hitsCount) / lookupsCount : 0.0,
+                                                   benchmark::Counter::kAvgThreads);
+}
+
+static void BM_PoolInsertConcurrent(benchmark::State& state)
+{
+    const auto keys = MakeKeys("thread_" + std::to_string(state.thread_index()) + ".key_", insertsPerThread);
+    if (state.thread_index() == 0)
+    {
+        insertPool = std::make_unique<Core::_StringPool<char>>();
+    }
+
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        const auto& key = keys[index++ % keys.size()];
+        benchmark::DoNotOptimize(insertPool->Add(key.data(), key.size()));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        insertPool.reset();
+    }
+}
+
+// the baseline: a plain set behind one global mutex, i.e. what callers had to do before the pool became thread-safe
+static void BM_GlobalMutexLookupConcurrent(benchmark::State& state)
+{
+    static std::mutex mutex;
+    static const std::unordered_set<std::string> strings(GetInternedKeys().begin(), GetInternedKeys().end());
+
+    const auto& keys = GetInternedKeys();
+    std::size_t index = static_cast<std::size_t>(state.thread_index()) * 7919;
+    for (auto _ : state)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        benchmark::DoNotOptimize(strings.find(keys[index++ % keys.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// the layout of the pool before the arenas: a node per atom plus a separate heap block for its characters
+static void BM_HeapPerAtomMemory(benchmark::State& state)
+{
+    const auto keys = MakeKeys("service.metrics.requests.key_", static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        Bench::AllocationCounter::Start();
+        {
+            std::unordered_map<std::size_t, std::pair<std::unique_ptr<char[]>, std::size_t>> strings;
+            for (const auto& key : keys)
+            {
+                auto ptr = std::make_unique<char[]>(key.size() + 1);
+                memcpy(ptr.get(), key.data(), key.size());
+                strings.emplace(std::hash<std::string_view>{}(key), std::make_pair(std::move(ptr), key.size()));
+            }
+            benchmark::DoNotOptimize(strings);
+        }
+        const auto allocations = Bench::AllocationCounter::Stop();
+
+        state.counters["AllocsPerAtom"] = static_cast<double>(allocations.allocationsCount) / keys.size();
+        state.counters["BytesPerAtom"] = static_cast<double>(allocations.allocatedBytes) / keys.size();
+    }
+}
+
+static void BM_PoolMemory(benchmark::State& state)
+{
+    const auto keys = MakeKeys("service.metrics.requests.key_", static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        Bench::AllocationCounter::Start();
+        {
+            Core::_StringPool<char> pool;
+            for (const auto& key : keys)
+            {
+                benchmark::DoNotOptimize(pool.Add(key.data(), key.size()));
+            }
+
+            const auto statistics = pool.GetStatistics();
+            state.counters["PoolBytesPerAtom"] = static_cast<double>(statistics.reservedBytes) / statistics.atomsCount;
+        }
+        const auto allocations = Bench::AllocationCounter::Stop();
+
+        state.counters["AllocsPerAtom"] = static_cast<double>(allocations.allocationsCount) / keys.size();
+        state.counters["BytesPerAtom"] = static_cast<double>(allocations.allocatedBytes) / keys.size();
+    }
+}
+
+static void BM_PoolLookupProbeLength(benchmark::State& state)
+{
+    const auto keys = MakeKeys("service.metrics.requests.key_", static_cast<int>(state.range(0)));
+    Core::_StringPool<char> pool;
+    for (const auto& key : keys)
+    {
+        benchmark::DoNotOptimize(pool.Add(key.data(), key.size()));
+    }
+
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        const auto& key = keys[index++ % keys.size()];
+        benchmark::DoNotOptimize(pool.Add(key.data(), key.size()));
+    }
+
+    const auto statistics = pool.GetStatistics();
+    state.counters["MaxProbeLength"] = static_cast<double>(statistics.maxProbeLength);
+    state.counters["AvgProbeLength"] = statistics.averageProbeLength;
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_StringAtomKeyedMapLookup(benchmark::State& state)
+{
+    std::vector<Core::StringAtom> atoms;
+    std::unordered_map<Core::StringAtom, int> map;
+    for (const auto& key : GetInternedKeys())
+    {
+        atoms.push_back(Core::StringAtom::Intern(key));
+        map.emplace(atoms.back(), static_cast<int>(map.size()));
+    }
+
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.find(atoms[index++ % atoms.size()]));
+    }
+    state.counters["KeyBytes"] = sizeof(Core::StringAtom);
+}
+
+static void BM_AtomIdKeyedMapLookup(benchmark::State& state)
+{
+    std::vector<Core::AtomId> ids;
+    std::unordered_map<Core::AtomId, int> map;
+    for (const auto& key : GetInternedKeys())
+    {
+        ids.push_back(Core::StringAtom::Intern(key).GetAtomId());
+        map.emplace(ids.back(), static_cast<int>(map.size()));
+    }
+
+    std::size_t index = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.find(ids[index++ % ids.size()]));
+    }
+    state.counters["KeyBytes"] = sizeof(Core::AtomId);
+}
+
+// ingest of a record batch whose keys are mostly interned already
+static void BM_PoolAddLoop(benchmark::State& state)
+{
+    const auto keys = MakeKeys("service.metrics.requests.key_", static_cast<int>(state.range(0)));
+    Core::_StringPool<char> pool;
+    for (auto _ : state)
+    {
+        for (const auto& key : keys)
+        {
+            benchmark::DoNotOptimize(pool.Add(key.data(), key.size()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+static void BM_PoolAddBatch(benchmark::State& state)
+{
+    const auto keys = MakeKeys("service.metrics.requests.key_", static_cast<int>(state.range(0)));
+    const std::vector<std::string_view> views(keys.begin(), keys.end());
+    std::vector<Core::StringDataReadOnly<char>> out(views.size());
+    Core::_StringPool<char> pool;
+    for (auto _ : state)
+    {
+        pool.AddBatch(views, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// startup of an application which interns its whole vocabulary from scratch
+static void BM_PoolColdStartup(benchmark::State& state)
+{
+    const auto keys = MakeKeys("service.metrics.requests.key_", static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        Core::_StringPool<char> pool;
+        for (const auto& key : keys)
+        {
+            benchmark::DoNotOptimize(pool.Add(key.data(), key.size()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// the same startup, but the vocabulary is mapped from a snapshot saved by the previous run
+static void BM_PoolSnapshotStartup(benchmark::State& state)
+{
+    const auto keys = MakeKeys("service.metrics.requests.key_", static_cast<int>(state.range(0)));
+    const auto path = std::filesystem::temp_directory_path() / "StringPoolBench.Snapshot.bin";
+    {
+        Core::_StringPool<char> pool;
+        for (const auto& key : keys)
+        {
+            benchmark::DoNotOptimize(pool.Add(key.data(), key.size()));
+        }
+        if (!pool.SaveSnapshot(path))
+        {
+            state.SkipWithError("Impossible to save the snapshot");
+            return;
+        }
+    }
+
+    for (auto _ : state)
+    {
+        Core::_StringPool<char> pool;
+        benchmark::DoNotOptimize(pool.LoadSnapshot(path));
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+    std::filesystem::remove(path);
+}
+
+BENCHMARK(BM_PoolLookupConcurrent)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_PoolLookupHotKeysConcurrent)->ArgsProduct({ { 64, 256, 4096 }, { 0, 1 } })->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_PoolInsertConcurrent)->ThreadRange(1, 16)->Iterations(insertsPerThread)->UseRealTime();
+BENCHMARK(BM_GlobalMutexLookupConcurrent)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_HeapPerAtomMemory)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PoolMemory)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PoolLookupProbeLength)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 22);
+BENCHMARK(BM_StringAtomKeyedMapLookup);
+BENCHMARK(BM_AtomIdKeyedMapLookup);
+BENCHMARK(BM_PoolAddLoop)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_PoolAddBatch)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_PoolColdStartup)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PoolSnapshotStartup)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -24,10 +24,13 @@
 
 #include "Core/CommonInterfaces.h"
 
+#include <concepts>
 #include <type_traits>
 
 namespace Core
 {
+    // The interfaces have no virtual functions, so an iterator stays as small and cheap to copy as a pointer. The
+    // operations which a derived iterator must implement are checked by the concepts at the end of the file.
 
     template<class T, class DerivedIterator, class CopyAndMovePolicy, bool IsIgnoreDataRef = false>
     class IInputIterator : public CopyAndMovePolicy, public ISwappable<DerivedIterator>
@@ -38,14 +41,6 @@ namespace Core
         using DataT = T;
         using DataRefT = std::conditional_t<IsIgnoreDataRef, DataT, DataT&>;
 
-        [[nodiscard]] virtual bool operator==(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual bool operator!=(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual const DataRefT operator*() const noexcept = 0;
-
-        [[nodiscard]] virtual const DataRefT operator->() const = 0;
-
     protected:
         IInputIterator() = default;
     };
@@ -59,14 +54,6 @@ namespace Core
         using DataT = T;
         using DataRefT = std::conditional_t<IsIgnoreDataRef, DataT, DataT&>;
 
-        [[nodiscard]] virtual bool operator==(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual bool operator!=(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual DataRefT operator*() noexcept = 0;
-
-        [[nodiscard]] virtual DataRefT operator->() noexcept = 0;
-
     protected:
         IOutputIterator() = default;
     };
@@ -80,22 +67,6 @@ namespace Core
         using DataT = T;
         using DataRefT = std::conditional_t<IsIgnoreDataRef, DataT, DataT&>;
 
-        [[nodiscard]] virtual bool operator==(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual bool operator!=(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual const DataRefT operator*() const noexcept = 0;
-
-        [[nodiscard]] virtual const DataRefT operator->() const = 0;
-
-        [[nodiscard]] virtual DataRefT operator*() noexcept = 0;
-
-        [[nodiscard]] virtual DataRefT operator->() noexcept = 0;
-
-        virtual DerivedIterator& operator++() noexcept = 0;
-
-        virtual DerivedIterator operator++(int) noexcept = 0;
-
     protected:
         IForwardIterator() = default;
     };
@@ -109,26 +80,6 @@ namespace Core
         using DataT = T;
         using DataRefT = std::conditional_t<IsIgnoreDataRef, DataT, DataT&>;
 
-        [[nodiscard]] virtual bool operator==(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual bool operator!=(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual const DataRefT operator*() const noexcept = 0;
-
-        [[nodiscard]] virtual const DataRefT operator->() const = 0;
-
-        [[nodiscard]] virtual DataRefT operator*() noexcept = 0;
-
-        [[nodiscard]] virtual DataRefT operator->() noexcept = 0;
-
-        virtual DerivedIterator& operator++() noexcept = 0;
-
-        virtual DerivedIterator operator++(int) noexcept = 0;
-
-        virtual DerivedIterator& operator--() noexcept = 0;
-
-        virtual DerivedIterator operator--(int) noexcept = 0;
-
     protected:
         IBidirectionalIterator() = default;
     };
@@ -142,44 +93,46 @@ namespace Core
         using DataT = T;
         using DataRefT = std::conditional_t<IsIgnoreDataRef, DataT, DataT&>;
 
-        [[nodiscard]] virtual bool operator==(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual bool operator!=(const DerivedIterator&) const noexcept = 0;
-
-        [[nodiscard]] virtual const DataRefT operator*() const noexcept = 0;
-
-        [[nodiscard]] virtual const DataRefT operator->() const = 0;
-
-        [[nodiscard]] virtual DataRefT operator*() noexcept = 0;
-
-        [[nodiscard]] virtual DataRefT operator->() noexcept = 0;
-
-        virtual DerivedIterator& operator++() noexcept = 0;
-
-        virtual DerivedIterator operator++(int) noexcept = 0;
-
-        virtual DerivedIterator& operator--() noexcept = 0;
-
-        virtual DerivedIterator operator--(int) noexcept = 0;
-
-        virtual DerivedIterator& operator+=(int step) noexcept = 0;
-
-        virtual DerivedIterator& operator-=(int step) noexcept = 0;
-
-        virtual DerivedIterator operator+(int step) const noexcept = 0;
-
-        virtual DerivedIterator operator-(int step) const noexcept = 0;
+    protected:
+        IRandomAccessIterator() = default;
+    };
 
-        [[nodiscard]] virtual bool operator>(const DerivedIterator& other) const noexcept = 0;
+    template<class T>
+    concept IsInputIterator = IsSwappable<T> && requires(const T& iterator) {
+        { iterator == iterator } -> std::convertible_to<bool>;
+        { iterator != iterator } -> std::convertible_to<bool>;
+        *iterator;
+    };
 
-        [[nodiscard]] virtual bool operator>=(const DerivedIterator& other) const noexcept = 0;
+    template<class T>
+    concept IsOutputIterator = IsSwappable<T> && requires(T& iterator) {
+        { iterator == iterator } -> std::convertible_to<bool>;
+        { iterator != iterator } -> std::convertible_to<bool>;
+        *iterator;
+    };
 
-        [[nodiscard]] virtual bool operator<(const DerivedIterator& other) const noexcept = 0;
+    template<class T>
+    concept IsForwardIterator = IsInputIterator<T> && IsOutputIterator<T> && requires(T& iterator) {
+        { ++iterator } -> std::same_as<T&>;
+        { iterator++ } -> std::same_as<T>;
+    };
 
-        [[nodiscard]] virtual bool operator<=(const DerivedIterator& other) const noexcept = 0;
+    template<class T>
+    concept IsBidirectionalIterator = IsForwardIterator<T> && requires(T& iterator) {
+        { --iterator } -> std::same_as<T&>;
+        { iterator-- } -> std::same_as<T>;
+    };
 
-    protected:
-        IRandomAccessIterator() = default;
+    template<class T>
+    concept IsRandomAccessIterator = IsBidirectionalIterator<T> && requires(T& iterator, const T& other, int step) {
+        { iterator += step } -> std::same_as<T&>;
+        { iterator -= step } -> std::same_as<T&>;
+        { other + step } -> std::same_as<T>;
+        { other - step } -> std::same_as<T>;
+        { other > other } -> std::convertible_to<bool>;
+        { other >= other } -> std::convertible_to<bool>;
+        { other < other } -> std::convertible_to<bool>;
+        { other <= other } -> std::convertible_to<bool>;
     };
 
 } // namespace Core
\ No newline at end of file
@@ -27,8 +27,12 @@
 #include "Delegate.h"
 #include "Enum.h"
 #include "Math.h"
+#include "MemoryMappedFile.h"
+#include "MultiMatcher.h"
 #include "Position.h"
 #include "Rect.h"
+#include "Rope.h"
 #include "Singleton.h"
 #include "Size.h"
-#include "String.h"
\ No newline at end of file
+#include "String.h"
+#include "StringView.h"
\ No newline at end of file
@@ -25,14 +25,14 @@
 namespace Core
 {
 
+    /// @brief Derived must have 'void Swap(Derived&)', it's checked by IsSwappable instead of a virtual function
     template<class Derived>
     struct ISwappable
     {
         using DerivedT = Derived;
-
-        virtual ~ISwappable() = default;
-
-        virtual void Swap(DerivedT&) = 0;
     };
 
+    template<class T>
+    concept IsSwappable = requires(T& first, T& second) { first.Swap(second); };
+
 } // namespace Core
\ No newline at end of file
@@ -52,7 +52,7 @@ namespace Core
             {
             }
 
-            ~ID() override
+            ~ID()
             {
                 if (_owner)
                 {
@@ -0,0 +1,177 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "Utils/CopyableAndMoveableBehaviour.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Core
+{
+    /// @brief read-only mapping of a whole file into the memory
+    class MemoryMappedFile : public Utils::NotCopyableButMoveable
+    {
+    public:
+        MemoryMappedFile() = default;
+
+        explicit MemoryMappedFile(const std::filesystem::path& path) { Open(path); }
+
+        MemoryMappedFile(MemoryMappedFile&& other) noexcept { *this = std::move(other); }
+
+        MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Close();
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+#ifdef _WIN32
+                _file = std::exchange(other._file, INVALID_HANDLE_VALUE);
+                _mapping = std::exchange(other._mapping, nullptr);
+#endif
+            }
+
+            return *this;
+        }
+
+        ~MemoryMappedFile() { Close(); }
+
+        bool Open(const std::filesystem::path& path)
+        {
+            Close();
+
+#ifdef _WIN32
+            _file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (_file == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0)
+            {
+                Close();
+                return false;
+            }
+
+            _mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!_mapping)
+            {
+                Close();
+                return false;
+            }
+
+            _data = static_cast<const std::byte*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!_data)
+            {
+                Close();
+                return false;
+            }
+            _size = static_cast<std::size_t>(size.QuadPart);
+#else
+            const int file = open(path.c_str(), O_RDONLY);
+            if (file < 0)
+            {
+                return false;
+            }
+
+            struct stat status{};
+            if (fstat(file, &status) != 0 || status.st_size == 0)
+            {
+                close(file);
+                return false;
+            }
+
+            void* data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+            // the mapping stays valid without the descriptor
+            close(file);
+            if (data == MAP_FAILED)
+            {
+                return false;
+            }
+
+            _data = static_cast<const std::byte*>(data);
+            _size = static_cast<std::size_t>(status.st_size);
+#endif
+
+            return true;
+        }
+
+        void Close() noexcept
+        {
+#ifdef _WIN32
+            if (_data)
+            {
+                UnmapViewOfFile(_data);
+            }
+            if (_mapping)
+            {
+                CloseHandle(_mapping);
+            }
+            if (_file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(_file);
+            }
+            _mapping = nullptr;
+            _file = INVALID_HANDLE_VALUE;
+#else
+            if (_data)
+            {
+                munmap(const_cast<std::byte*>(_data), _size);
+            }
+#endif
+            _data = nullptr;
+            _size = 0;
+        }
+
+        [[nodiscard]] bool IsOpen() const noexcept { return _data != nullptr; }
+        [[nodiscard]] const std::byte* Data() const noexcept { return _data; }
+        [[nodiscard]] std::size_t Size() const noexcept { return _size; }
+
+    private:
+        const std::byte* _data = nullptr;
+        std::size_t _size = 0;
+#ifdef _WIN32
+        HANDLE _file = INVALID_HANDLE_VALUE;
+        HANDLE _mapping = nullptr;
+#endif
+    };
+} // namespace Core
@@ -0,0 +1,405 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Core/Assert.h"
+#include "Core/String.h"
+#include "Utils/CopyableAndMoveableBehaviour.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+    /// @brief finds a set of keywords in one pass over a text (Aho-Corasick). The keywords are compiled once into a
+    /// complete automaton: every state has a transition for every character class, so a character costs one table lookup
+    /// whatever the count of keywords is. Only the characters which occur in the keywords get their own class, the rest
+    /// share one, which keeps the table small.
+    template<class CharType>
+    class MultiMatcher : public Utils::CopyableAndMoveable
+    {
+    public:
+        using CharT = CharType;
+        using Self = MultiMatcher<CharT>;
+        using StringT = BaseString<CharT>;
+        using SizeT = typename StringT::SizeT;
+        using StdStringViewT = typename StringT::StdStringViewT;
+        using StateT = std::uint32_t;
+
+        /// @brief a keyword found in the text, the id is the index of the keyword in the list given to the constructor
+        struct Match
+        {
+            SizeT patternId = 0;
+            SizeT offset = 0;
+            SizeT size = 0;
+
+            [[nodiscard]] bool operator==(const Match& other) const noexcept = default;
+        };
+
+        /// @brief keeps the state between the chunks of a text, so keywords which cross a chunk boundary are found.
+        /// The offsets of the matches are counted from the beginning of the first chunk.
+        class Stream
+        {
+        public:
+            explicit Stream(const Self& matcher) noexcept
+                : _matcher{ &matcher }
+            {
+            }
+
+            /// @brief see MultiMatcher::Iterate, the lambda which returns false stops the reports of the rest of this chunk
+            /// only. The next chunk continues as if the whole chunk was fed.
+            template<class Lambda>
+            void Feed(StdStringViewT chunk, Lambda&& lambda)
+            {
+                const auto passed = _matcher->Run(chunk, _state, _offset, lambda);
+                _matcher->Advance(chunk.substr(passed), _state);
+                _offset += chunk.size();
+            }
+
+            void Reset() noexcept
+            {
+                _state = 0;
+                _offset = 0;
+            }
+
+            /// @brief count of the characters fed since the last reset
+            [[nodiscard]] SizeT Offset() const noexcept { return _offset; }
+
+        private:
+            const Self* _matcher = nullptr;
+            StateT _state = 0;
+            SizeT _offset = 0;
+        };
+
+    public:
+        MultiMatcher() = default;
+
+        MultiMatcher(std::initializer_list<StdStringViewT> patterns)
+        {
+            Compile(patterns);
+        }
+
+        template<std::ranges::input_range Range>
+            requires std::is_convertible_v<std::ranges::range_reference_t<const Range>, StdStringViewT>
+        explicit MultiMatcher(const Range& patterns)
+        {
+            Compile(patterns);
+        }
+
+        [[nodiscard]] SizeT PatternsCount() const noexcept { return _patternSizes.size(); }
+        [[nodiscard]] SizeT StatesCount() const noexcept { return _states.size(); }
+
+        /// @brief calls the lambda with every match (overlapping ones too) in the order of their ends, a longer keyword
+        /// first if several end at the same character. It stops when the lambda returns false.
+        template<class Lambda>
+        void Iterate(StdStringViewT text, Lambda&& lambda) const
+        {
+            StateT state = 0;
+            Run(text, state, 0, lambda);
+        }
+
+        [[nodiscard]] std::vector<Match> FindAll(StdStringViewT text) const
+        {
+            std::vector<Match> matches;
+            Iterate(text, [&matches](const Match& match) {
+                matches.push_back(match);
+                return true;
+            });
+            return matches;
+        }
+
+        /// @brief the match which ends first
+        [[nodiscard]] std::optional<Match> FindFirst(StdStringViewT text) const
+        {
+            std::optional<Match> result;
+            Iterate(text, [&result](const Match& match) {
+                result = match;
+                return false;
+            });
+            return result;
+        }
+
+        [[nodiscard]] bool IsContainAny(StdStringViewT text) const { return FindFirst(text).has_value(); }
+
+        [[nodiscard]] Stream MakeStream() const noexcept { return Stream(*this); }
+
+    private:
+        struct State
+        {
+            // the keywords which end exactly in this state are _outputs[outputBegin, outputEnd)
+            std::uint32_t outputBegin = 0;
+            std::uint32_t outputEnd = 0;
+            // the nearest state on the failure chain which has outputs, 0 if there is none
+            StateT outputLink = 0;
+        };
+
+        template<class Range>
+        void Compile(const Range& patterns)
+        {
+            CompileClasses(patterns);
+
+            // the trie, 0 is the root and the missing transitions are 0 too since no transition leads to the root
+            _states.emplace_back();
+            _transitions.assign(_stride, 0);
+            std::vector<std::pair<StateT, SizeT>> ends;
+            for (const auto& pattern : patterns)
+            {
+                const StdStringViewT view(pattern);
+                const auto id = _patternSizes.size();
+                _patternSizes.push_back(view.size());
+                if (!Verify(!view.empty(), "Impossible to find an empty string."))
+                {
+                    continue;
+                }
+
+                StateT state = 0;
+                for (const auto ch : view)
+                {
+                    const auto index = IndexOf(state, ClassOf(ch));
+                    if (_transitions[index] == 0)
+                    {
+                        if (!Verify((_states.size() + 1) * _stride <= std::numeric_limits<StateT>::max() / 2, "Too many keywords."))
+                        {
+                            // the matcher which has no states finds nothing
+                            _states.clear();
+                            _transitions.clear();
+                            return;
+                        }
+
+                        _transitions[index] = static_cast<StateT>(_states.size());
+                        _states.emplace_back();
+                        _transitions.resize(_transitions.size() + _stride, 0);
+                    }
+                    state = _transitions[index];
+                }
+                ends.emplace_back(state, id);
+            }
+
+            std::ranges::sort(ends);
+            _outputs.reserve(ends.size());
+            for (const auto& [state, id] : ends)
+            {
+                if (_states[state].outputBegin == _states[state].outputEnd)
+                {
+                    _states[state].outputBegin = static_cast<std::uint32_t>(_outputs.size());
+                }
+                _outputs.push_back(id);
+                _states[state].outputEnd = static_cast<std::uint32_t>(_outputs.size());
+            }
+
+            CompileFailures();
+        }
+
+        template<class Range>
+        void CompileClasses(const Range& patterns)
+        {
+            // class 0 is for the characters which aren't in any keyword
+            std::vector<CharT> chars;
+            for (const auto& pattern : patterns)
+            {
+                const StdStringViewT view(pattern);
+                chars.insert(chars.end(), view.begin(), view.end());
+            }
+            std::ranges::sort(chars);
+            chars.erase(std::unique(chars.begin(), chars.end()), chars.end());
+
+            _classesCount = 1;
+            for (const auto ch : chars)
+            {
+                const auto code = static_cast<std::make_unsigned_t<CharT>>(ch);
+                if (code < _lowClasses.size())
+                {
+                    _lowClasses[code] = _classesCount;
+                }
+                else
+                {
+                    _highClasses.emplace_back(ch, _classesCount);
+                }
+                ++_classesCount;
+            }
+            _stride = _classesCount + (_classesCount & 1);
+        }
+
+        /// @brief breadth-first: the failure of a state is known when its children are visited. The missing transitions
+        /// are replaced by the transitions of the failure, which makes the automaton complete.
+        void CompileFailures()
+        {
+            std::vector<StateT> failures(_states.size(), 0);
+            std::vector<StateT> queue;
+            queue.reserve(_states.size());
+            for (StateT ch = 0; ch < _classesCount; ++ch)
+            {
+                if (const auto child = _transitions[ch]; child != 0)
+                {
+                    queue.push_back(child);
+                }
+            }
+
+            for (SizeT i = 0; i < queue.size(); ++i)
+            {
+                const auto state = queue[i];
+                const auto failure = failures[state];
+                const auto& failureState = _states[failure];
+                _states[state].outputLink = failureState.outputBegin != failureState.outputEnd ? failure : failureState.outputLink;
+
+                for (StateT ch = 0; ch < _classesCount; ++ch)
+                {
+                    auto& transition = _transitions[IndexOf(state, ch)];
+                    const auto failureTransition = _transitions[IndexOf(failure, ch)];
+                    if (transition != 0)
+                    {
+                        failures[transition] = failureTransition;
+                        queue.push_back(transition);
+                    }
+                    else
+                    {
+                        transition = failureTransition;
+                    }
+                }
+            }
+
+            // a transition keeps the offset of the target row and the lowest bit tells if the target reports matches
+            for (auto& transition : _transitions)
+            {
+                const auto& target = _states[transition];
+                const bool isReporting = target.outputBegin != target.outputEnd || target.outputLink != 0;
+                transition = transition * _stride | static_cast<StateT>(isReporting);
+            }
+        }
+
+        [[nodiscard]] SizeT IndexOf(StateT state, StateT charClass) const noexcept
+        {
+            return static_cast<SizeT>(state) * _stride + charClass;
+        }
+
+        [[nodiscard]] StateT ClassOf(CharT ch) const noexcept
+        {
+            const auto code = static_cast<std::make_unsigned_t<CharT>>(ch);
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _lowClasses[code];
+            }
+            else
+            {
+                if (code < _lowClasses.size())
+                {
+                    return _lowClasses[code];
+                }
+
+                const auto found = std::ranges::lower_bound(_highClasses, ch, {}, &std::pair<CharT, StateT>::first);
+                return found != _highClasses.end() && found->first == ch ? found->second : 0;
+            }
+        }
+
+        /// @brief moves the state (the last transition) over the text. The offsets of the matches start from 'baseOffset'.
+        /// @return count of the passed characters, it's less than the text size if the lambda stopped the run
+        template<class Lambda>
+        SizeT Run(StdStringViewT text, StateT& state, SizeT baseOffset, Lambda& lambda) const
+        {
+            if (_states.empty())
+            {
+                return text.size();
+            }
+
+            // the state is a transition: no multiplication in the loop
+            const StateT* transitions = _transitions.data();
+            for (SizeT i = 0; i < text.size(); ++i)
+            {
+                state = transitions[(state & ~StateT{ 1 }) + ClassOf(text[i])];
+                if ((state & 1) && !Report(state / _stride, baseOffset + i + 1, lambda))
+                {
+                    return i + 1;
+                }
+            }
+
+            return text.size();
+        }
+
+        /// @brief moves the state over the text without reporting the matches
+        void Advance(StdStringViewT text, StateT& state) const noexcept
+        {
+            if (_states.empty())
+            {
+                return;
+            }
+
+            const StateT* transitions = _transitions.data();
+            for (const auto ch : text)
+            {
+                state = transitions[(state & ~StateT{ 1 }) + ClassOf(ch)];
+            }
+        }
+
+        template<class Lambda>
+        bool Report(StateT state, SizeT end, Lambda& lambda) const
+        {
+            const State* current = &_states[state];
+            if (current->outputBegin == current->outputEnd)
+            {
+                current = &_states[current->outputLink];
+            }
+
+            while (true)
+            {
+                for (auto i = current->outputBegin; i != current->outputEnd; ++i)
+                {
+                    const auto id = _outputs[i];
+                    const auto size = _patternSizes[id];
+                    if (!lambda(Match{ id, end - size, size }))
+                    {
+                        return false;
+                    }
+                }
+
+                if (current->outputLink == 0)
+                {
+                    return true;
+                }
+                current = &_states[current->outputLink];
+            }
+        }
+
+    private:
+        std::vector<State> _states;
+        // _transitions[state * _stride + class] is the next state, see CompileFailures for the compiled form
+        std::vector<StateT> _transitions;
+        std::vector<SizeT> _outputs;
+        std::vector<SizeT> _patternSizes;
+        std::array<StateT, 256> _lowClasses{};
+        // the classes of the characters above 255 sorted by the character
+        std::vector<std::pair<CharT, StateT>> _highClasses;
+        StateT _classesCount = 1;
+        // the row size, it's even, so the lowest bit of a row offset is free
+        StateT _stride = 2;
+    };
+
+    using StringMultiMatcher = MultiMatcher<char>;
+    using WStringMultiMatcher = MultiMatcher<wchar_t>;
+} // namespace Core
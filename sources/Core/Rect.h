@@ -28,6 +28,8 @@
 #include "Utils/Concepts.h"
 #include "Utils/CopyableAndMoveableBehaviour.h"
 
+#include <type_traits>
+
 namespace Core
 {
     template<Utils::IsArithmetic T>
@@ -166,4 +168,10 @@ namespace Core
     using DRect = Rect<double>;
     using IRect = Rect<int>;
 
+    // rects are stored and copied in bulk, so they must stay plain data without a vptr or padding
+    static_assert(std::is_trivially_copyable_v<FRect> && std::is_trivially_copyable_v<DRect> && std::is_trivially_copyable_v<IRect>);
+#ifndef CORE_DEBUG
+    static_assert(sizeof(FRect) == 4 * sizeof(float) && sizeof(DRect) == 4 * sizeof(double) && sizeof(IRect) == 4 * sizeof(int));
+#endif
+
 } // namespace Core
@@ -0,0 +1,396 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Core/Assert.h"
+#include "Core/String.h"
+#include "Utils/CopyableAndMoveableBehaviour.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace Core
+{
+    /// @brief a text as a balanced (AVL) tree of immutable chunks. Copies share the tree and an edit builds O(log n) new
+    /// nodes while the chunks are reused, so insert, erase, substring and concatenation don't copy the text.
+    template<class CharType>
+    class Rope : public Utils::CopyableAndMoveable
+    {
+    public:
+        using CharT = CharType;
+        using Self = Rope<CharT>;
+        using StringT = BaseString<CharT>;
+        using SizeT = typename StringT::SizeT;
+        using IndexT = typename StringT::IndexT;
+        using StdStringViewT = typename StringT::StdStringViewT;
+
+        /// @brief neighbouring chunks which are shorter than this together are merged into one chunk, so small edits
+        /// don't fragment the text into tiny leaves
+        constexpr static SizeT mergeSize = 256;
+
+    public:
+        Rope() = default;
+
+        /// @brief the string becomes the first chunk without a copy of its characters (a static atom stays in the pool)
+        explicit Rope(StringT string)
+            : _root{ MakeLeaf(std::move(string)) }
+        {
+        }
+
+        explicit Rope(StdStringViewT string)
+            : Rope(StringT(string))
+        {
+        }
+
+        explicit Rope(const CharT* string)
+            : Rope(StdStringViewT(string))
+        {
+        }
+
+        [[nodiscard]] SizeT Size() const noexcept { return SizeOf(_root); }
+        [[nodiscard]] SizeT Length() const noexcept { return Size(); }
+        [[nodiscard]] bool IsEmpty() const noexcept { return !_root; }
+
+        /// @brief height of the tree, a leaf has 0
+        [[nodiscard]] int Height() const noexcept { return std::max(HeightOf(_root), 0); }
+
+        /// @brief O(log n)
+        [[nodiscard]] CharT operator[](IndexT index) const noexcept
+        {
+            if (!Verify(index < Size(), "Invalid index"))
+            {
+                return {};
+            }
+
+            const Node* node = _root.get();
+            while (!node->IsLeaf())
+            {
+                if (index < node->left->size)
+                {
+                    node = node->left.get();
+                }
+                else
+                {
+                    index -= node->left->size;
+                    node = node->right.get();
+                }
+            }
+
+            return (*node->chunk)[node->offset + index];
+        }
+
+        Self& Append(const Self& other)
+        {
+            _root = Concat(_root, other._root);
+            return *this;
+        }
+
+        Self& operator+=(const Self& other) { return Append(other); }
+        Self& operator+=(StdStringViewT string) { return Append(Self(string)); }
+
+        [[nodiscard]] Self operator+(const Self& other) const
+        {
+            Self result;
+            result._root = Concat(_root, other._root);
+            return result;
+        }
+
+        Self& Insert(IndexT index, const Self& other)
+        {
+            if (!Verify(index <= Size(), "Invalid index"))
+            {
+                return *this;
+            }
+
+            auto [first, second] = Split(_root, index);
+            _root = Concat(Concat(std::move(first), other._root), std::move(second));
+            return *this;
+        }
+
+        Self& Insert(IndexT index, StdStringViewT string) { return Insert(index, Self(string)); }
+
+        Self& Erase(IndexT index, SizeT count = 1)
+        {
+            if (!Verify(index <= Size(), "Invalid index"))
+            {
+                return *this;
+            }
+
+            auto [first, rest] = Split(_root, index);
+            auto [erased, second] = Split(rest, std::min(count, SizeOf(rest)));
+            _root = Concat(std::move(first), std::move(second));
+            return *this;
+        }
+
+        /// @brief 'length' characters from 'index' (fewer at the end), it's a length like in Erase. Unlike BaseString::SubStr,
+        /// whose second argument is the end index, and the rope itself isn't changed.
+        [[nodiscard]] Self SubRope(IndexT index, SizeT length) const
+        {
+            if (!Verify(index <= Size(), "Invalid index"))
+            {
+                return {};
+            }
+
+            Self result;
+            result._root = Split(Split(_root, index).second, length).first;
+            return result;
+        }
+
+        /// @brief calls the lambda for every chunk in order without copying the characters, it stops when the lambda
+        /// returns false
+        template<class Lambda>
+        void IterateChunks(Lambda&& lambda) const
+        {
+            IterateChunks(_root.get(), lambda);
+        }
+
+        /// @brief a rope which is a whole single chunk gives the chunk itself, otherwise the text is copied into one
+        /// allocation of the exact size
+        [[nodiscard]] StringT ToString() const
+        {
+            if (!_root)
+            {
+                return {};
+            }
+
+            if (_root->IsLeaf() && _root->offset == 0 && _root->size == _root->chunk->Size())
+            {
+                return *_root->chunk;
+            }
+
+            StringT result;
+            result.ResizeAndOverwrite(Size(), [this](CharT* data, SizeT size) {
+                IterateChunks([&data](StdStringViewT chunk) {
+                    std::char_traits<CharT>::copy(data, chunk.data(), chunk.size());
+                    data += chunk.size();
+                    return true;
+                });
+                return size;
+            });
+            return result;
+        }
+
+        [[nodiscard]] bool operator==(StdStringViewT other) const
+        {
+            if (other.size() != Size())
+            {
+                return false;
+            }
+
+            bool isEqual = true;
+            IterateChunks([&other, &isEqual](StdStringViewT chunk) {
+                isEqual = other.starts_with(chunk);
+                other.remove_prefix(chunk.size());
+                return isEqual;
+            });
+            return isEqual;
+        }
+
+    private:
+        struct Node
+        {
+            // a branch has both children, a leaf has a chunk
+            std::shared_ptr<const Node> left;
+            std::shared_ptr<const Node> right;
+            std::shared_ptr<const StringT> chunk;
+            SizeT offset = 0;
+            SizeT size = 0;
+            int height = 0;
+
+            [[nodiscard]] bool IsLeaf() const noexcept { return !left; }
+            [[nodiscard]] StdStringViewT View() const noexcept { return chunk->ToStringView().substr(offset, size); }
+        };
+
+        using NodePtr = std::shared_ptr<const Node>;
+
+        [[nodiscard]] static SizeT SizeOf(const NodePtr& node) noexcept { return node ? node->size : 0; }
+        [[nodiscard]] static int HeightOf(const NodePtr& node) noexcept { return node ? node->height : -1; }
+
+        [[nodiscard]] static NodePtr MakeLeaf(StringT&& string)
+        {
+            if (string.IsEmpty())
+            {
+                return nullptr;
+            }
+
+            const auto size = string.Size();
+            return MakeLeaf(std::make_shared<const StringT>(std::move(string)), 0, size);
+        }
+
+        [[nodiscard]] static NodePtr MakeLeaf(std::shared_ptr<const StringT> chunk, SizeT offset, SizeT size)
+        {
+            auto node = std::make_shared<Node>();
+            node->chunk = std::move(chunk);
+            node->offset = offset;
+            node->size = size;
+            return node;
+        }
+
+        [[nodiscard]] static NodePtr MakeBranch(NodePtr left, NodePtr right)
+        {
+            auto node = std::make_shared<Node>();
+            node->size = left->size + right->size;
+            node->height = std::max(left->height, right->height) + 1;
+            node->left = std::move(left);
+            node->right = std::move(right);
+            return node;
+        }
+
+        [[nodiscard]] static NodePtr RotateLeft(const NodePtr& node)
+        {
+            const auto& right = node->right;
+            return MakeBranch(MakeBranch(node->left, right->left), right->right);
+        }
+
+        [[nodiscard]] static NodePtr RotateRight(const NodePtr& node)
+        {
+            const auto& left = node->left;
+            return MakeBranch(left->left, MakeBranch(left->right, node->right));
+        }
+
+        /// @brief O(|height(left) - height(right)|), the result is balanced if both trees are
+        [[nodiscard]] static NodePtr Concat(NodePtr left, NodePtr right)
+        {
+            if (!left || !right)
+            {
+                return left ? left : right;
+            }
+
+            if (left->IsLeaf() && right->IsLeaf() && left->size + right->size <= mergeSize)
+            {
+                return MakeLeaf(StrCat<CharT>(left->View(), right->View()));
+            }
+
+            const int difference = left->height - right->height;
+            if (difference > 1)
+            {
+                return JoinRight(left, std::move(right));
+            }
+            if (difference < -1)
+            {
+                return JoinLeft(std::move(left), right);
+            }
+            return MakeBranch(std::move(left), std::move(right));
+        }
+
+        // the taller tree is descended along its inner side until the heights match, then AVL rotations restore the
+        // balance on the way back
+        [[nodiscard]] static NodePtr JoinRight(const NodePtr& left, NodePtr right)
+        {
+            const auto& outer = left->left;
+            const auto& inner = left->right;
+            if (HeightOf(inner) <= HeightOf(right) + 1)
+            {
+                auto middle = Concat(inner, std::move(right));
+                if (HeightOf(middle) <= HeightOf(outer) + 1)
+                {
+                    return MakeBranch(outer, std::move(middle));
+                }
+                return RotateLeft(MakeBranch(outer, RotateRight(middle)));
+            }
+
+            auto middle = JoinRight(inner, std::move(right));
+            if (HeightOf(middle) <= HeightOf(outer) + 1)
+            {
+                return MakeBranch(outer, std::move(middle));
+            }
+            return RotateLeft(MakeBranch(outer, std::move(middle)));
+        }
+
+        [[nodiscard]] static NodePtr JoinLeft(NodePtr left, const NodePtr& right)
+        {
+            const auto& inner = right->left;
+            const auto& outer = right->right;
+            if (HeightOf(inner) <= HeightOf(left) + 1)
+            {
+                auto middle = Concat(std::move(left), inner);
+                if (HeightOf(middle) <= HeightOf(outer) + 1)
+                {
+                    return MakeBranch(std::move(middle), outer);
+                }
+                return RotateRight(MakeBranch(RotateLeft(middle), outer));
+            }
+
+            auto middle = JoinLeft(std::move(left), inner);
+            if (HeightOf(middle) <= HeightOf(outer) + 1)
+            {
+                return MakeBranch(std::move(middle), outer);
+            }
+            return RotateRight(MakeBranch(std::move(middle), outer));
+        }
+
+        /// @brief the first 'index' characters and the rest. O(log n): only the nodes on the path are rebuilt.
+        [[nodiscard]] static std::pair<NodePtr, NodePtr> Split(const NodePtr& node, SizeT index)
+        {
+            if (!node || index == 0)
+            {
+                return { nullptr, node };
+            }
+            if (index >= node->size)
+            {
+                return { node, nullptr };
+            }
+
+            if (node->IsLeaf())
+            {
+                return { MakeLeaf(node->chunk, node->offset, index), MakeLeaf(node->chunk, node->offset + index, node->size - index) };
+            }
+
+            const auto leftSize = node->left->size;
+            if (index < leftSize)
+            {
+                auto [first, second] = Split(node->left, index);
+                return { std::move(first), Concat(std::move(second), node->right) };
+            }
+            if (index > leftSize)
+            {
+                auto [first, second] = Split(node->right, index - leftSize);
+                return { Concat(node->left, std::move(first)), std::move(second) };
+            }
+            return { node->left, node->right };
+        }
+
+        template<class Lambda>
+        static bool IterateChunks(const Node* node, Lambda& lambda)
+        {
+            if (!node)
+            {
+                return true;
+            }
+
+            if (node->IsLeaf())
+            {
+                return static_cast<bool>(lambda(node->View()));
+            }
+
+            return IterateChunks(node->left.get(), lambda) && IterateChunks(node->right.get(), lambda);
+        }
+
+    private:
+        NodePtr _root;
+    };
+
+    using StringRope = Rope<char>;
+    using WStringRope = Rope<wchar_t>;
+} // namespace Core
@@ -24,8 +24,7 @@
 
 #include "Utils/CopyableAndMoveableBehaviour.h"
 
-#include <memory>
-#include <mutex>
+#include <type_traits>
 
 namespace Core
 {
@@ -36,25 +35,15 @@ namespace Core
     class Singleton : public CopyBehaviour
     {
     public:
+        /// @brief thread-safe: the first call constructs the object, concurrent callers wait for it (a magic static)
         static T& Instance()
         {
-            static std::unique_ptr<T> object;
-            static std::mutex mutex;
-            if (!object)
-            {
-                std::lock_guard<decltype(mutex)> lockGuard(mutex);
-                if (!object)
-                {
-                    object = std::unique_ptr<T>(new T);
-                }
-            }
-
-            return *object.get();
+            static T object;
+            return object;
         }
 
-        virtual ~Singleton() = default;
-
     protected:
         Singleton() = default;
+        ~Singleton() = default;
     };
 } // namespace Core
@@ -27,6 +27,8 @@
 #include "Utils/CopyableAndMoveableBehaviour.h"
 #include "glm/glm.hpp"
 
+#include <type_traits>
+
 namespace Core
 {
     template<Utils::IsArithmetic T, int Dimension>
@@ -297,4 +299,8 @@ namespace Core
     using DSize3 = Size<double, 3>;
     using ISize3 = Size<int, 3>;
 
+    static_assert(std::is_trivially_copyable_v<FSize2> && std::is_trivially_copyable_v<FSize3>);
+    static_assert(sizeof(FSize2) == 2 * sizeof(float) && sizeof(DSize2) == 2 * sizeof(double) && sizeof(ISize2) == 2 * sizeof(int));
+    static_assert(sizeof(FSize3) == 3 * sizeof(float) && sizeof(DSize3) == 3 * sizeof(double) && sizeof(ISize3) == 3 * sizeof(int));
+
 } // namespace Core
\ No newline at end of file
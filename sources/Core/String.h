@@ -25,19 +25,30 @@
 #include "Core/AbstractIterators.h"
 #include "Core/Assert.h"
 #include "Core/CommonEnums.h"
-#include "Singleton.h"
+#include "Core/StringPool.h"
+#include "Core/StringCase.h"
+#include "Core/StringSearch.h"
+#include "Core/StringToolset.h"
+#include "Utils/Concepts.h"
 #include "Utils/CopyableAndMoveableBehaviour.h"
 
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <compare>
 #include <cstring>
 #include <cwctype>
 #include <functional>
+#include <memory_resource>
+#include <new>
 #include <optional>
+#include <ranges>
 #include <regex>
 #include <set>
+#include <span>
 #include <type_traits>
-#include <unordered_map>
+#include <utility>
 #include <vector>
-#include <xstring>
 
 namespace Core
 {
@@ -48,251 +59,35 @@ namespace Core
         Dynamic
     };
 
-    template<class CharType>
-    struct _StringSettings : public Utils::Abstract
-    {
-        using CharT = CharType;
-        using SizeT = std::size_t;
-        using HashT = std::size_t;
-        using IndexT = std::size_t;
-        constexpr static SizeT invalidSize = ~static_cast<SizeT>(0);
-    };
-
-    template<class CharType>
-    struct _StringToolset;
-
-    template<>
-    struct _StringToolset<char> : public Utils::Abstract
-    {
-        using CharT = char;
-        using StdStringT = std::basic_string<CharT, std::char_traits<CharT>, std::allocator<CharT>>;
-        using StdStringViewT = std::basic_string_view<CharT, std::char_traits<CharT>>;
-        using StdRegex = std::basic_regex<CharT, std::regex_traits<CharT>>;
-        using SizeT = typename _StringSettings<CharT>::SizeT;
-
-        [[nodiscard]] static bool IsSpace(int ch) { return static_cast<bool>(isspace(ch)); }
-        [[nodiscard]] static SizeT Length(const CharT* string) noexcept { return static_cast<SizeT>(strlen(string)); }
-
-        [[nodiscard]] static int ToInt(const CharT* str) noexcept { return atoi(str); }
-        [[nodiscard]] static float ToFloat(const CharT* str) noexcept { return static_cast<float>(atof(str)); }
-        [[nodiscard]] static double ToDouble(const CharT* str) noexcept { return atof(str); }
-        [[nodiscard]] static long long ToLongLong(const CharT* str) noexcept { return atoll(str); }
-
-        static void FromInt(int value, CharT* buffer, SizeT bufferSize)
-        {
-            if (const auto errorCode = snprintf(buffer, bufferSize, "%d", value); errorCode < 0)
-            {
-                Assert("Impossible to convert 'int' value to string.");
-            }
-        }
-
-        static void FromFloat(float value, CharT* buffer, SizeT bufferSize)
-        {
-            if (const auto errorCode = snprintf(buffer, bufferSize, "%f", value); errorCode < 0)
-            {
-                Assert("Impossible to convert 'float' value to string.");
-            }
-        }
-
-        static void FromDouble(double value, CharT* buffer, SizeT bufferSize)
-        {
-            if (const auto errorCode = snprintf(buffer, bufferSize, "%lf", value); errorCode < 0)
-            {
-                Assert("Impossible to convert 'double' value to string.");
-            }
-        }
-
-        static void FromUnsignedLongLong(unsigned long long value, CharT* buffer, SizeT bufferSize)
-        {
-            if (const auto errorCode = snprintf(buffer, bufferSize, "%llu", value); errorCode < 0)
-            {
-                Assert("Impossible to convert 'long long' value to string.");
-            }
-        }
-
-        [[nodiscard]] static CharT* StrTok(CharT* string, const CharT* delim, CharT*& context) noexcept { return strtok_s(string, delim, &context); };
-        [[nodiscard]] static CharT* StrStr(CharT* mainString, const CharT* subString) noexcept { return strstr(mainString, subString); };
-
-        [[nodiscard]] static int ToUpper(const CharT ch) noexcept { return toupper(ch); };
-        [[nodiscard]] static int ToLower(const CharT ch) noexcept { return tolower(ch); };
-
-        [[nodiscard]] static Comparison Cmp(const CharT* str1, const CharT* str2) noexcept
-        {
-            const int result = strcmp(str1, str2);
-            if (result == 0)
-            {
-                return Comparison::Equal;
-            }
-            if (result > 0)
-            {
-                return Comparison::Greater;
-            }
-
-            return Comparison::Less;
-        }
-    };
-
-    template<>
-    struct _StringToolset<wchar_t> : public Utils::Abstract
+    /// @brief capacity (including the null-terminator) which a dynamic string gets when it has to hold 'size' characters.
+    /// The policy is selected by CORE_STRING_GROWTH_POLICY.
+    struct StringGrowthDouble
     {
-        using CharT = wchar_t;
-        using StdStringT = std::basic_string<CharT, std::char_traits<CharT>, std::allocator<CharT>>;
-        using StdStringViewT = std::basic_string_view<CharT, std::char_traits<CharT>>;
-        using StdRegex = std::basic_regex<CharT, std::regex_traits<CharT>>;
-        using SizeT = typename _StringSettings<CharT>::SizeT;
-
-        [[nodiscard]] static bool IsSpace(wint_t ch) { return static_cast<bool>(std::iswspace(ch)); }
-        [[nodiscard]] static SizeT Length(const CharT* string) noexcept { return static_cast<SizeT>(wcslen(string)); }
-
-        [[nodiscard]] static int ToInt(const CharT* str) noexcept { return _wtoi(str); }
-        [[nodiscard]] static float ToFloat(const CharT* str) noexcept { return static_cast<float>(_wtof(str)); }
-        [[nodiscard]] static double ToDouble(const CharT* str) noexcept { return _wtof(str); }
-        [[nodiscard]] static long long ToLongLong(const CharT* str) noexcept { return _wtoll(str); }
-
-        static void FromInt(int value, CharT* buffer, SizeT bufferSize)
-        {
-            if (const auto errorCode = _snwprintf_s(buffer, bufferSize, bufferSize, L"%d", value); errorCode < 0)
-            {
-                Assert("Impossible to convert 'int' value to string.");
-            }
-        }
-
-        static void FromFloat(float value, CharT* buffer, SizeT bufferSize)
-        {
-            if (const auto errorCode = _snwprintf_s(buffer, bufferSize, bufferSize, L"%f", value); errorCode < 0)
-            {
-                Assert("Impossible to convert 'float' value to string.");
-            }
-        }
-
-        static void FromDouble(double value, CharT* buffer, SizeT bufferSize)
-        {
-            if (const auto errorCode = _snwprintf_s(buffer, bufferSize, bufferSize, L"%lf", value); errorCode < 0)
-            {
-                Assert("Impossible to convert 'double' value to string.");
-            }
-        }
-
-        static void FromUnsignedLongLong(unsigned long long value, CharT* buffer, SizeT bufferSize)
-        {
-            if (const auto errorCode = _snwprintf_s(buffer, bufferSize, bufferSize, L"%llu", value); errorCode < 0)
-            {
-                Assert("Impossible to convert 'long long' value to string.");
-            }
-        }
-
-        [[nodiscard]] static CharT* StrTok(CharT* string, const CharT* delim, CharT*& context) noexcept { return wcstok_s(string, delim, &context); };
-        [[nodiscard]] static CharT* StrStr(CharT* mainString, const CharT* subString) noexcept { return wcsstr(mainString, subString); };
-
-        [[nodiscard]] static std::wint_t ToUpper(const CharT ch) noexcept { return towupper(ch); };
-        [[nodiscard]] static std::wint_t ToLower(const CharT ch) noexcept { return towlower(ch); };
-
-        [[nodiscard]] static Comparison Cmp(const CharT* str1, const CharT* str2) noexcept
-        {
-            const int result = wcscmp(str1, str2);
-            if (result == 0)
-            {
-                return Comparison::Equal;
-            }
-            if (result > 0)
-            {
-                return Comparison::Greater;
-            }
-
-            return Comparison::Less;
-        }
+        [[nodiscard]] constexpr static std::size_t Capacity(std::size_t size) noexcept { return size * 2 + 1; }
     };
 
-    template<class CharType>
-    struct StringDataReadOnly
+    struct StringGrowthOneAndHalf
     {
-        using Settings = _StringSettings<CharType>;
-
-        typename Settings::CharT* str;
-        typename Settings::SizeT size = Settings::invalidSize;
+        [[nodiscard]] constexpr static std::size_t Capacity(std::size_t size) noexcept { return size + size / 2 + 1; }
     };
 
-    template<class CharType>
-    struct StringData
+    /// @brief doesn't reserve space for the next appends, so a series of appends is quadratic
+    struct StringGrowthExact
     {
-        using Toolset = _StringToolset<CharType>;
-        using Settings = _StringSettings<CharType>;
-        using SmartPointer = std::unique_ptr<typename Settings::CharT[]>;
-
-        StringData(SmartPointer&& ptr, typename Settings::SizeT newSize)
-            : str{ std::move(ptr) },
-              size{ newSize }
-        {
-        }
-
-        StringData(const CharType* newString, typename Settings::SizeT newSize)
-        {
-            str = SmartPointer(new CharType[newSize + static_cast<decltype(newSize)>(1)]);
-            memcpy_s(str.get(), size * sizeof(CharType), newString, newSize * sizeof(CharType));
-        }
-
-        [[nodiscard]] StringDataReadOnly<CharType> ToReadOnly() noexcept { return StringDataReadOnly<CharType>{ str.get(), size }; }
-
-        [[nodiscard]] bool operator<(const StringData& other) const
-        {
-            if (str)
-            {
-                return Toolset::Cmp(str.get(), other.str.get()) == Comparison::Less;
-            }
-            return false;
-        }
-
-        [[nodiscard]] bool operator==(const StringData& other) const
-        {
-            if (str)
-            {
-                return Toolset::Cmp(str.get(), other.str.get()) == Comparison::Equal;
-            }
-            return false;
-        }
-
-        SmartPointer str;
-        typename Settings::SizeT size = Settings::invalidSize;
+        [[nodiscard]] constexpr static std::size_t Capacity(std::size_t size) noexcept { return size + 1; }
     };
 
-    template<class CharType>
-    class _StringPool : public Singleton<_StringPool<CharType>, Utils::NotCopyableAndNotMoveable>
-    {
-    public:
-        using CharT = CharType;
-        using Toolset = _StringToolset<CharT>;
-        using StdStringViewT = typename Toolset::StdStringViewT;
-        using Settings = _StringSettings<CharT>;
-        using HashT = typename Settings::HashT;
-        using SizeT = typename Settings::SizeT;
-        using StringDataT = StringData<CharT>;
-        using StringDataReadOnlyT = StringDataReadOnly<CharT>;
-
-    public:
-        [[nodiscard]] StringDataReadOnlyT Add(const CharT* string, typename Settings::SizeT size, bool isCompileTime = false)
-        {
-            const auto currentHash = std::hash<StdStringViewT>{}({ string, size });
-            if (auto&& it = _strings.find(currentHash); it != _strings.end())
-            {
-                return it->second.ToReadOnly();
-            }
-
-            auto&& ptr = std::make_unique<CharT[]>(size + static_cast<typename Settings::SizeT>(1));
-            memcpy(ptr.get(), string, size * sizeof(CharT));
-            auto* addr = ptr.get();
-            _strings.emplace(currentHash, StringDataT{ std::move(ptr), size });
-
-            return StringDataReadOnlyT{ addr, size };
-        }
-
-    private:
-        std::unordered_map<HashT, StringDataT> _strings;
-    };
+#ifndef CORE_STRING_GROWTH_POLICY
+    #define CORE_STRING_GROWTH_POLICY Core::StringGrowthDouble
+#endif
 
     class Iterator;
     template<class CharType>
     class BaseString;
 
+    template<class CharType = void, class... Pieces>
+    [[nodiscard]] auto StrCat(const Pieces&... pieces);
+
     template<class T>
     concept IsFormattableType =
         std::is_same_v<std::decay_t<T>, int> || std::is_same_v<std::decay_t<T>, double> || std::is_same_v<std::decay_t<T>, float> ||
@@ -315,12 +110,24 @@ namespace Core
         using StdStringViewT = typename Toolset::StdStringViewT;
         using StringDataReadOnlyT = StringDataReadOnly<CharT>;
         using StringPool = _StringPool<CharT>;
+        using Hasher = _StringHasher<CharT>;
+        using Case = _StringCase<CharT>;
+        using Search = _StringSearch<CharT>;
         using StdRegex = typename Toolset::StdRegex;
+        using GrowthPolicy = CORE_STRING_GROWTH_POLICY;
 
         using value_type = CharT;
         using pointer = value_type*;
         using difference_type = long long;
 
+        /// @brief count of characters including the null-terminator which a dynamic string keeps without a heap allocation
+        constexpr static SizeT inlineCapacity = 16 / sizeof(CharT);
+
+#ifdef CORE_STRING_MEMOIZE_HASH
+        /// @brief the memoized hash which means there is no hash yet
+        constexpr static HashT notComputedHash = 0;
+#endif
+
     public:
         template<bool IsReversed>
         class Iterator : public IRandomAccessIterator<CharT, Iterator<IsReversed>, Utils::CopyableAndMoveable, true>
@@ -337,59 +144,59 @@ namespace Core
         public:
             Iterator() = default;
 
-            [[nodiscard]] bool operator==(const Self& other) const noexcept override { return _data == other._data; };
+            [[nodiscard]] bool operator==(const Self& other) const noexcept { return _data == other._data; };
 
-            [[nodiscard]] bool operator!=(const Self& other) const noexcept override { return _data != other._data; };
+            [[nodiscard]] bool operator!=(const Self& other) const noexcept { return _data != other._data; };
 
-            [[nodiscard]] const typename Super::DataRefT operator*() const noexcept override { return *_data; }
+            [[nodiscard]] const typename Super::DataRefT operator*() const noexcept { return *_data; }
 
-            [[nodiscard]] const typename Super::DataRefT operator->() const override { return *_data; }
+            [[nodiscard]] const typename Super::DataRefT operator->() const { return *_data; }
 
-            [[nodiscard]] typename Super::DataRefT operator*() noexcept override { return *_data; }
+            [[nodiscard]] typename Super::DataRefT operator*() noexcept { return *_data; }
 
-            [[nodiscard]] typename Super::DataRefT operator->() noexcept override { return *_data; }
+            [[nodiscard]] typename Super::DataRefT operator->() noexcept { return *_data; }
 
-            Self& operator++() noexcept override
+            Self& operator++() noexcept
             {
                 _data += (IsReversed ? -1 : 1);
                 return *this;
             }
 
-            Self operator++(int) noexcept override
+            Self operator++(int) noexcept
             {
                 auto temp = *this;
                 _data += (IsReversed ? -1 : 1);
                 return temp;
             }
 
-            Self& operator--() noexcept override
+            Self& operator--() noexcept
             {
                 _data -= (IsReversed ? -1 : 1);
                 return *this;
             }
 
-            Self operator--(int) noexcept override
+            Self operator--(int) noexcept
             {
                 auto temp = *this;
                 _data -= (IsReversed ? -1 : 1);
                 return temp;
             }
 
-            Self& operator+=(int step) noexcept override
+            Self& operator+=(int step) noexcept
             {
                 _data += (IsReversed ? -step : step);
                 return *this;
             }
 
-            Self& operator-=(int step) noexcept override
+            Self& operator-=(int step) noexcept
             {
                 _data -= step;
                 return *this;
             }
 
-            Self operator+(int step) const noexcept override { return Self{ _data + (IsReversed ? -step : step), _owner }; }
+            Self operator+(int step) const noexcept { return Self{ _data + (IsReversed ? -step : step), _owner }; }
 
-            Self operator-(int step) const noexcept override { return Self{ _data - (IsReversed ? -step : step), _owner }; }
+            Self operator-(int step) const noexcept { return Self{ _data - (IsReversed ? -step : step), _owner }; }
 
             difference_type operator-(const Self& other) const noexcept
             {
@@ -401,23 +208,23 @@ namespace Core
                 return {};
             }
 
-            [[nodiscard]] bool operator>(const Self& other) const noexcept override { return (*this <=> other) == Comparison::Greater; }
+            [[nodiscard]] bool operator>(const Self& other) const noexcept { return (*this <=> other) == Comparison::Greater; }
 
-            [[nodiscard]] bool operator>=(const Self& other) const noexcept override
+            [[nodiscard]] bool operator>=(const Self& other) const noexcept
             {
                 const auto result = *this <=> other;
                 return result == Comparison::Equal || result == Comparison::Greater;
             }
 
-            [[nodiscard]] bool operator<(const Self& other) const noexcept override { return (*this <=> other) == Comparison::Less; }
+            [[nodiscard]] bool operator<(const Self& other) const noexcept { return (*this <=> other) == Comparison::Less; }
 
-            [[nodiscard]] bool operator<=(const Self& other) const noexcept override
+            [[nodiscard]] bool operator<=(const Self& other) const noexcept
             {
                 const auto result = *this <=> other;
                 return result == Comparison::Equal || result == Comparison::Less;
             }
 
-            void Swap(Self& other) override
+            void Swap(Self& other)
             {
                 auto temp = *this;
                 *this = other;
@@ -484,214 +291,128 @@ namespace Core
         [[nodiscard]] const ReverseIteratorT rend() const noexcept { return ReverseIteratorT{ _string, this }; }
         [[nodiscard]] const ReverseIteratorT crend() const noexcept { return ReverseIteratorT{ _string, this }; }
 
-        [[nodiscard]] static Self Intern(const CharT* newString) { return Self{ StringPool::Instance().Add(newString, Toolset::Length(newString)) }; }
+        [[nodiscard]] static Self Intern(const CharT* newString) { return Intern(StringPool::Instance(), newString); }
 
+        /// @param isCompileTime the string is null-terminated and has static storage duration, so it's interned without a copy
         [[nodiscard]] static Self Intern(const CharT* newString, SizeT size, bool isCompileTime = false)
         {
-            return Self{ StringPool::Instance().Add(newString, size, isCompileTime) };
+            return Intern(StringPool::Instance(), newString, size, isCompileTime);
         }
 
-        [[nodiscard]] static Self Intern(StdStringViewT string) { return Self{ StringPool::Instance().Add(string.data(), string.size()) }; }
-
-        [[nodiscard]] SizeT Size() const noexcept { return _size; }
-        [[nodiscard]] SizeT Length() const noexcept { return _size; }
-        [[nodiscard]] bool IsEmpty() const noexcept { return _string == nullptr || _size == 0; }
-        [[nodiscard]] explicit operator const CharT*() const noexcept { return _string; }
-        [[nodiscard]] operator StdStringViewT() const noexcept { return ToStringView(); }
-        [[nodiscard]] CharT operator[](IndexT index) const noexcept { return _string[index]; }
-
-        [[nodiscard]] bool operator==(const Self& other) const
+        /// @brief interns a literal which was passed as a template argument (see _StringLiteral). The pool is asked only
+        /// once per literal and gets the hash which was computed at compile time.
+        template<auto Literal>
+        [[nodiscard]] static Self InternLiteral()
         {
-            if (IsEmpty() || other.IsEmpty())
-            {
-                if (IsEmpty() && other.IsEmpty())
-                {
-                    return true;
-                }
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return IsStatic() && other.IsStatic() ? _string == other._string : Toolset::Cmp(_string, other._string) == Comparison::Equal;
+            static const StringDataReadOnlyT data = StringPool::Instance().AddWithHash(Literal.data, Literal.Size(), Literal.hash, true);
+            return Self{ data };
         }
 
-        [[nodiscard]] bool operator!=(const Self& other) const
-        {
-            if (IsEmpty() || other.IsEmpty())
-            {
-                if ((IsEmpty() && !other.IsEmpty()) || (!IsEmpty() && other.IsEmpty()))
-                {
-                    return true;
-                }
+        [[nodiscard]] static Self Intern(StdStringViewT string) { return Intern(StringPool::Instance(), string); }
 
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return IsStatic() && other.IsStatic() ? _string != other._string : Toolset::Cmp(_string, other._string) != Comparison::Equal;
-        }
+        /// @brief interns all the strings at once, it's much cheaper than Intern for every string (see _StringPool::AddBatch)
+        /// @param out receives the atoms in the order of the input, it must have the same size
+        static void InternBatch(std::span<const StdStringViewT> strings, std::span<Self> out) { InternBatch(StringPool::Instance(), strings, out); }
 
-        [[nodiscard]] bool operator>(const Self& other) const
-        {
-            if (IsEmpty() || other.IsEmpty())
-            {
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return Toolset::Cmp(_string, other._string) == Comparison::Greater;
-        }
+        // The same functions for a scoped pool instead of the global one. The atoms must not outlive their pool,
+        // which frees all its strings at once when it's destroyed.
+        [[nodiscard]] static Self Intern(StringPool& pool, const CharT* newString) { return Self{ pool.Add(newString, Toolset::Length(newString)) }; }
 
-        [[nodiscard]] bool operator>=(const Self& other) const
+        [[nodiscard]] static Self Intern(StringPool& pool, const CharT* newString, SizeT size, bool isCompileTime = false)
         {
-            if (IsEmpty() || other.IsEmpty())
-            {
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            const auto result = Toolset::Cmp(_string, other._string);
-            return result == Comparison::Greater || result == Comparison::Equal;
+            return Self{ pool.Add(newString, size, isCompileTime) };
         }
 
-        [[nodiscard]] bool operator<(const Self& other) const
+        [[nodiscard]] static Self Intern(StringPool& pool, StdStringViewT string) { return Self{ pool.Add(string.data(), string.size()) }; }
+
+        static void InternBatch(StringPool& pool, std::span<const StdStringViewT> strings, std::span<Self> out)
         {
-            if (IsEmpty() || other.IsEmpty())
+            if (!Verify(strings.size() == out.size(), "The output must have the same size as the input."))
             {
-                Assert("Impossible to work with nullptr string.");
-                return {};
+                return;
             }
-            return Toolset::Cmp(_string, other._string) == Comparison::Less;
-        }
 
-        [[nodiscard]] bool operator<=(const Self& other) const
-        {
-            if (IsEmpty() || other.IsEmpty())
+            std::vector<StringDataReadOnlyT> data(strings.size());
+            pool.AddBatch(strings, data);
+            for (SizeT i = 0; i < data.size(); ++i)
             {
-                Assert("Impossible to work with nullptr string.");
-                return {};
+                out[i] = Self{ data[i] };
             }
-            const auto result = Toolset::Cmp(_string, other._string);
-            return result == Comparison::Less || result == Comparison::Equal;
         }
 
-        [[nodiscard]] bool operator==(const CharT* other) const
-        {
-            if (IsEmpty() || !other)
-            {
-                if (_string && _string[0] == 0 && other && other[0] == 0)
-                {
-                    return true;
-                }
+        /// @brief the id is valid only for static strings and only within the pool of the string
+        [[nodiscard]] AtomId GetAtomId() const noexcept { return IsStatic() && _entry ? _entry->id : AtomId{}; }
 
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return Toolset::Cmp(_string, other) == Comparison::Equal;
-        }
+        [[nodiscard]] static Self FromAtomId(AtomId id) { return FromAtomId(StringPool::Instance(), id); }
 
-        [[nodiscard]] bool operator!=(const CharT* other) const
+        [[nodiscard]] static Self FromAtomId(const StringPool& pool, AtomId id)
         {
-            if (IsEmpty() || !other)
+            const auto data = pool.Resolve(id);
+            if (!Verify(data.str, "Invalid atom id."))
             {
-                Assert("Impossible to work with nullptr string.");
                 return {};
             }
-            return Toolset::Cmp(_string, other) != Comparison::Equal;
-        }
 
-        [[nodiscard]] bool operator>(const CharT* other) const
-        {
-            if (IsEmpty() || !other)
-            {
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return Toolset::Cmp(_string, other) == Comparison::Greater;
+            StringPool::Retain(*data.entry);
+            return Self{ data };
         }
 
-        [[nodiscard]] bool operator>=(const CharT* other) const
+        /// @brief both strings are interned into the same pool, so they are equal only if they share the characters
+        [[nodiscard]] bool IsFromSamePool(const Self& other) const noexcept
         {
-            if (IsEmpty() || !other)
-            {
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            const auto result = Toolset::Cmp(_string, other);
-            return result == Comparison::Greater || result == Comparison::Equal;
+            return IsStatic() && other.IsStatic() && _entry && other._entry && _entry->owner == other._entry->owner;
         }
 
-        [[nodiscard]] bool operator<(const CharT* other) const
-        {
-            if (IsEmpty() || !other)
-            {
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return Toolset::Cmp(_string, other) == Comparison::Less;
-        }
+        [[nodiscard]] SizeT Size() const noexcept { return _size; }
+        [[nodiscard]] SizeT Length() const noexcept { return _size; }
+        [[nodiscard]] bool IsEmpty() const noexcept { return _string == nullptr || _size == 0; }
+        [[nodiscard]] explicit operator const CharT*() const noexcept { return _string; }
+        [[nodiscard]] operator StdStringViewT() const noexcept { return ToStringView(); }
+        [[nodiscard]] CharT operator[](IndexT index) const noexcept { return _string[index]; }
 
-        [[nodiscard]] bool operator<=(const CharT* other) const
+        /// @brief the sizes are compared first, then the characters by memcmp. Atoms of the same pool are equal only if
+        /// they are the same atom, and strings with different memoized hashes differ.
+        [[nodiscard]] bool operator==(const Self& other) const noexcept
         {
-            if (IsEmpty() || !other)
+            if (IsFromSamePool(other))
             {
-                Assert("Impossible to work with nullptr string.");
-                return {};
+                return _string == other._string;
             }
-            const auto result = Toolset::Cmp(_string, other);
-            return result == Comparison::Less || result == Comparison::Equal;
-        }
-
-        [[nodiscard]] bool operator==(StdStringViewT other) const
-        {
-            if (IsEmpty() || other.empty())
+#ifdef CORE_STRING_MEMOIZE_HASH
+            const auto hash = _hash.load(std::memory_order_relaxed);
+            const auto otherHash = other._hash.load(std::memory_order_relaxed);
+            if (hash != notComputedHash && otherHash != notComputedHash && hash != otherHash)
             {
-                if (_string && _string[0] == 0 && other.empty())
-                {
-                    return true;
-                }
-                Assert("Impossible to work with nullptr string.");
-                return {};
+                return false;
             }
-            return *this == other.data();
+#endif
+            return *this == other.ToStringView();
         }
 
-        [[nodiscard]] bool operator>(StdStringViewT other) const
+        [[nodiscard]] bool operator==(StdStringViewT other) const noexcept
         {
-            if (IsEmpty() || other.empty())
-            {
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return *this > other.data();
+            return _size == other.size() && (_size == 0 || std::char_traits<CharT>::compare(_string, other.data(), _size) == 0);
         }
 
-        [[nodiscard]] bool operator>=(StdStringViewT other) const
-        {
-            if (IsEmpty() || other.empty())
-            {
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return *this >= other.data();
-        }
+        [[nodiscard]] bool operator==(const CharT* other) const noexcept { return *this == ToView(other); }
 
-        [[nodiscard]] bool operator<(StdStringViewT other) const
-        {
-            if (IsEmpty() || other.empty())
-            {
-                Assert("Impossible to work with nullptr string.");
-                return {};
-            }
-            return *this < other.data();
-        }
+        /// @brief lexicographic by the characters as unsigned values (as strcmp), a prefix is less. Embedded zeros are
+        /// compared too. The other relational operators are rewritten from this one by the compiler for both orders of
+        /// the operands.
+        [[nodiscard]] std::strong_ordering operator<=>(const Self& other) const noexcept { return *this <=> other.ToStringView(); }
 
-        [[nodiscard]] bool operator<=(StdStringViewT other) const
+        [[nodiscard]] std::strong_ordering operator<=>(StdStringViewT other) const noexcept
         {
-            if (IsEmpty() || other.empty())
+            const SizeT size = std::min(_size, static_cast<SizeT>(other.size()));
+            if (const int result = size == 0 ? 0 : std::char_traits<CharT>::compare(_string, other.data(), size); result != 0)
             {
-                Assert("Impossible to work with nullptr string.");
-                return {};
+                return result <=> 0;
             }
-            return *this <= other.data();
+            return _size <=> static_cast<SizeT>(other.size());
         }
 
+        [[nodiscard]] std::strong_ordering operator<=>(const CharT* other) const noexcept { return *this <=> ToView(other); }
+
         [[nodiscard]] bool operator!() const noexcept { return IsEmpty(); }
         [[nodiscard]] explicit operator bool() const noexcept { return !IsEmpty(); }
 
@@ -760,9 +481,12 @@ namespace Core
         [[nodiscard]] const CharT* data() const noexcept { return _string; }
         [[nodiscard]] const CharT* Data() const noexcept { return data(); }
 
+        /// @brief with CORE_STRING_COPY_ON_WRITE the buffer isn't shared by the copies made afterwards, since the characters
+        /// can be changed through the pointer at any time
         [[nodiscard]] CharT* data() noexcept
         {
             TryToMakeAsDynamic();
+            SetBufferLeaked(true);
             return _string;
         }
 
@@ -924,14 +648,33 @@ namespace Core
             return temp;
         }
 
+        /// @brief O(1) for static strings: the pool has already computed the hash. With CORE_STRING_MEMOIZE_HASH dynamic
+        /// strings keep the hash until the next modification, a const string can be hashed by several threads at once.
         [[nodiscard]] HashT MakeHash() const noexcept
         {
-            if (!IsEmpty())
+            if (IsEmpty())
             {
-                return std::hash<StdStringViewT>{}({ _string, _size });
+                Assert("Impossible to make a hash from nullptr string.");
+                return {};
             }
-            Assert("Impossible to make a hash from nullptr string.");
-            return {};
+
+            if (_entry)
+            {
+                return _entry->hash;
+            }
+
+#ifdef CORE_STRING_MEMOIZE_HASH
+            auto hash = _hash.load(std::memory_order_relaxed);
+            if (hash == notComputedHash)
+            {
+                // every thread computes the same value, so the relaxed store can't publish a wrong one
+                hash = Hasher::Hash(_string, _size);
+                _hash.store(hash, std::memory_order_relaxed);
+            }
+            return hash;
+#else
+            return Hasher::Hash(_string, _size);
+#endif
         }
 
         Self& SubStr(IndexT index, SizeT count = 0) noexcept
@@ -985,29 +728,25 @@ namespace Core
 
         Self& Trim(CharT ch) noexcept { return TrimStart(ch).TrimEnd(ch); }
 
+        /// @brief see _StringCase
         Self& ToUpperCase() noexcept
         {
             if (!IsEmpty())
             {
                 TryToMakeAsDynamic();
-                for (IndexT i = 0; i < _size; ++i)
-                {
-                    _string[i] = Toolset::ToUpper(_string[i]);
-                }
+                Case::ToUpper(_string, _size);
             }
 
             return *this;
         }
 
+        /// @brief see _StringCase
         Self& ToLowerCase() noexcept
         {
             if (!IsEmpty())
             {
                 TryToMakeAsDynamic();
-                for (IndexT i = 0; i < _size; ++i)
-                {
-                    _string[i] = Toolset::ToLower(_string[i]);
-                }
+                Case::ToLower(_string, _size);
             }
 
             return *this;
@@ -1022,9 +761,7 @@ namespace Core
                     return *this;
                 }
 
-                Self temp(_string, index);
-                temp += _string + index + 1;
-                *this = std::move(temp);
+                *this = StrCat<CharT>(StdStringViewT(_string, index), StdStringViewT(_string + index + 1, _size - index - 1));
             }
 
             return *this;
@@ -1039,9 +776,7 @@ namespace Core
                     return *this;
                 }
 
-                Self temp(_string, from);
-                temp += _string + to + 1;
-                *this = std::move(temp);
+                *this = StrCat<CharT>(StdStringViewT(_string, from), StdStringViewT(_string + to + 1, _size - to - 1));
             }
 
             return *this;
@@ -1078,44 +813,93 @@ namespace Core
             {
                 if (auto* found = Find(mainValue))
                 {
-                    auto temp = Self(_string, found - _string);
-                    temp += newValue;
-                    temp += found + mainValue.size();
-                    *this = std::move(temp);
+                    const SizeT offset = found - _string;
+                    *this = StrCat<CharT>(StdStringViewT(_string, offset), newValue,
+                                          StdStringViewT(found + mainValue.size(), _size - offset - mainValue.size()));
                 }
             }
 
             return *this;
         }
 
+        using Replacement = std::pair<StdStringViewT, StdStringViewT>;
+
+        /// @brief replaces non-overlapping occurrences from left to right, the inserted values are not searched again. The
+        /// string is scanned twice: to measure and to write the result into one allocation of the exact size.
         Self& ReplaceAll(StdStringViewT mainValue, StdStringViewT newValue) noexcept
         {
             if (!IsEmpty())
             {
-                int offset = 0;
-                // TODO: optimize this code
-                while (auto* found = Find(mainValue, offset))
-                {
-                    offset = found - _string + newValue.size();
-                    auto temp = Self(_string, found - _string);
-                    temp += newValue;
-                    temp += found + mainValue.size();
-                    *this = std::move(temp);
-                }
+                const Replacement replacement(mainValue, newValue);
+                ReplaceMany(std::span(&replacement, 1));
             }
 
             return *this;
         }
 
-        [[nodiscard]] static bool IsSpace(CharT ch) noexcept { return Toolset::IsSpace(ch); }
-        [[nodiscard]] static bool IsContainChar(CharT ch, StdStringViewT set) noexcept
+        /// @brief replaces every 'first' of the replacements by its 'second' in one scan, e.g.
+        /// ReplaceMany({ { "&", "&amp;" }, { "<", "&lt;" } }). At every position the first pattern of the list that
+        /// matches wins, the scan continues after it, so the inserted values are never replaced again.
+        Self& ReplaceMany(std::initializer_list<Replacement> replacements) noexcept
         {
-            for (const auto value : set)
+            return ReplaceMany(std::span(replacements.begin(), replacements.size()));
+        }
+
+        Self& ReplaceMany(std::span<const Replacement> replacements) noexcept
+        {
+            if (IsEmpty() || replacements.empty())
             {
-                if (value == ch)
-                {
-                    return true;
-                }
+                return *this;
+            }
+
+            for (const auto& [from, to] : replacements)
+            {
+                if (!Verify(!from.empty(), "Impossible to replace an empty string."))
+                {
+                    return *this;
+                }
+            }
+
+            SizeT size = _size;
+            SizeT count = 0;
+            IterateReplacements(replacements, [&size, &count](SizeT, const Replacement& replacement) {
+                size = size - replacement.first.size() + replacement.second.size();
+                ++count;
+            });
+
+            if (count == 0)
+            {
+                return *this;
+            }
+
+            // the values may point into this string, so the result is written into another buffer
+            Self result(_resource);
+            result.ResizeAndOverwrite(size, [this, replacements](CharT* data, SizeT newSize) {
+                SizeT copied = 0;
+                IterateReplacements(replacements, [this, &data, &copied](SizeT offset, const Replacement& replacement) {
+                    std::char_traits<CharT>::copy(data, _string + copied, offset - copied);
+                    data += offset - copied;
+                    std::char_traits<CharT>::copy(data, replacement.second.data(), replacement.second.size());
+                    data += replacement.second.size();
+                    copied = offset + replacement.first.size();
+                });
+                std::char_traits<CharT>::copy(data, _string + copied, _size - copied);
+                return newSize;
+            });
+            *this = std::move(result);
+
+            return *this;
+        }
+
+        [[nodiscard]] static bool IsSpace(CharT ch) noexcept { return Toolset::IsSpace(ch); }
+        [[nodiscard]] static bool IsContainChar(CharT ch, StdStringViewT set) noexcept
+        {
+            for (const auto value : set)
+            {
+                if (value == ch)
+                {
+                    return true;
+                }
             }
 
             return false;
@@ -1158,26 +942,51 @@ namespace Core
         Self& operator+=(CharT ch) noexcept { return push_back(ch); }
         Self& operator+=(StdStringViewT str) noexcept { return push_back(str); }
 
-        Self& push_back(CharT ch) noexcept { return push_back(StdStringViewT(&ch, 1)); }
-        Self& PushBack(CharT ch) noexcept { return push_back(StdStringViewT(&ch, 1)); }
+        Self& push_back(CharT ch) noexcept { return PushBack(ch); }
+
+        Self& PushBack(CharT ch) noexcept
+        {
+            InvalidateHash();
+            DetachBuffer();
+            if (_size + static_cast<SizeT>(1) >= _capacity)
+            {
+                Reserve(_size + static_cast<SizeT>(1));
+            }
+
+            _string[_size] = ch;
+            _string[++_size] = 0;
+
+            return *this;
+        }
 
         Self& push_back(StdStringViewT str) noexcept { return PushBack(str); }
 
         Self& PushBack(StdStringViewT str) noexcept
         {
-            const auto oldSize = _size;
+            if (str.empty())
+            {
+                return *this;
+            }
+
+            InvalidateHash();
+            // a detached string doesn't own the appended characters even if they were a part of the shared buffer
+            DetachBuffer();
             const auto finalSize = _size + str.size();
             if (finalSize >= _capacity)
             {
+                // the appended characters can be a part of this string, the old buffer is freed by Reserve
+                const bool isOwnCharacters = _string && str.data() >= _string && str.data() < _string + _size;
+                const auto offset = isOwnCharacters ? str.data() - _string : 0;
                 Reserve(finalSize);
+                if (isOwnCharacters)
+                {
+                    str = StdStringViewT(_string + offset, str.size());
+                }
             }
 
-            for (IndexT i = oldSize, j = 0; i < finalSize && j < str.size(); ++i, ++j)
-            {
-                _string[i] = str[j];
-            }
-            _string[finalSize] = 0;
-            _size += str.size();
+            memcpy_s(_string + _size, str.size() * sizeof(CharT), str.data(), str.size() * sizeof(CharT));
+            _size = finalSize;
+            _string[_size] = 0;
 
             return *this;
         }
@@ -1189,8 +998,15 @@ namespace Core
 
         Self& PushFront(StdStringViewT str) noexcept
         {
+            if (str.empty())
+            {
+                return *this;
+            }
+
+            InvalidateHash();
             const auto oldSize = _size;
             const auto finalSize = _size + str.size();
+            DetachBuffer();
             if (finalSize >= _capacity)
             {
                 Reserve(finalSize);
@@ -1252,22 +1068,30 @@ namespace Core
 
         Self& shrink_to_fit() noexcept
         {
-            const auto* oldString = _string;
+            if (IsInline())
+            {
+                return *this;
+            }
+
+            auto* oldString = _string;
+            const auto oldCapacity = _capacity;
             const auto capacity = _size + static_cast<SizeT>(1);
 
-            if ((_string = new CharT[capacity]))
+            if ((_string = Allocate(capacity)))
             {
+                SetBufferLeaked(false);
                 _capacity = capacity;
-                memcpy_s(_string, _size * sizeof(CharT), oldString, _size);
+                memcpy_s(_string, _size * sizeof(CharT), oldString, _size * sizeof(CharT));
                 _string[_size] = 0;
 
                 if (_policy == StringPolicy::Static)
                 {
                     _policy = StringPolicy::Dynamic;
+                    ReleaseEntry();
                 }
                 else if (_policy == StringPolicy::Dynamic)
                 {
-                    delete[] oldString;
+                    Deallocate(oldString, oldCapacity);
                 }
             }
 
@@ -1276,6 +1100,9 @@ namespace Core
 
         [[nodiscard]] SizeT Capacity() const noexcept { return _capacity; }
 
+        /// @brief nullptr if the heap buffer is allocated by the global operator new
+        [[nodiscard]] std::pmr::memory_resource* GetMemoryResource() const noexcept { return _resource; }
+
         Self& Insert(IteratorT iterator, const CharT* str, SizeT size = Settings::invalidSize) noexcept
         {
             return insert(std::move(iterator), str, size);
@@ -1296,6 +1123,7 @@ namespace Core
 
         Self& insert(long long pos, const CharT* str, SizeT size = Settings::invalidSize) noexcept
         {
+            InvalidateHash();
             if (size == Settings::invalidSize)
             {
                 size = Toolset::Length(str);
@@ -1303,6 +1131,7 @@ namespace Core
 
             const auto oldSize = _size;
             const auto finalSize = _size + size;
+            DetachBuffer();
             if (finalSize >= _capacity)
             {
                 Reserve(finalSize);
@@ -1324,6 +1153,20 @@ namespace Core
         }
 
         [[nodiscard]] bool IsStatic() const noexcept { return _policy == StringPolicy::Static; }
+
+        /// @brief the characters are stored inside the object without a heap allocation
+        [[nodiscard]] bool IsInline() const noexcept { return _string == _inlineBuffer; }
+
+        /// @brief with CORE_STRING_COPY_ON_WRITE copies of a dynamic string share its heap buffer until one of them is
+        /// changed, the changed string gets its own copy first
+        [[nodiscard]] bool IsBufferShared() const noexcept
+        {
+#ifdef CORE_STRING_COPY_ON_WRITE
+            return _policy == StringPolicy::Dynamic && !IsInline() && GetSharedCounter(_string)->load(std::memory_order_acquire) != 1;
+#else
+            return false;
+#endif
+        }
         [[nodiscard]] bool IsDynamic() const noexcept { return _policy == StringPolicy::Dynamic; }
         [[nodiscard]] bool CheckForPolicy(StringPolicy policy) const noexcept { return _policy == policy; }
 
@@ -1336,27 +1179,35 @@ namespace Core
 
             if (isIgnoreCase)
             {
-                for (IndexT index = 0; _string[index] && index < other.size(); ++index)
-                {
-                    if (_string[index + 1ull] == 0 && other.size() == index + 1ull)
-                    {
-                        return Comparison::Equal;
-                    }
+                return CompareIgnoreCase(other);
+            }
 
-                    const auto diff = Toolset::ToUpper(_string[index]) - Toolset::ToUpper(other[index]);
-                    if (diff > 0 || _string[index + 1ull] == 0)
-                    {
-                        return Comparison::Greater;
-                    }
-                    if (diff < 0 || other.size() == index + 1ull)
-                    {
-                        return Comparison::Less;
-                    }
-                }
-                return Comparison::None;
+            const auto result = *this <=> other;
+            if (result == 0)
+            {
+                return Comparison::Equal;
+            }
+            return result < 0 ? Comparison::Less : Comparison::Greater;
+        }
+
+        /// @brief see _StringCase, a string which is a prefix of the other one is less
+        [[nodiscard]] Comparison CompareIgnoreCase(StdStringViewT other) const noexcept
+        {
+            const int result = Case::Compare(_string, other.data(), std::min(_size, static_cast<SizeT>(other.size())));
+            if (result != 0)
+            {
+                return result < 0 ? Comparison::Less : Comparison::Greater;
+            }
+            if (_size == other.size())
+            {
+                return Comparison::Equal;
             }
+            return _size < other.size() ? Comparison::Less : Comparison::Greater;
+        }
 
-            return Toolset::Cmp(_string, other.data());
+        [[nodiscard]] bool IsEqualIgnoreCase(StdStringViewT other) const noexcept
+        {
+            return _size == other.size() && Case::IsEqual(_string, other.data(), _size);
         }
 
         [[nodiscard]] StdRegexMatchResults FindRegex(StdStringViewT expr, int baseOffset = 0,
@@ -1396,36 +1247,49 @@ namespace Core
             }
         }
 
+        /// @brief see _StringSearch, the search is bounded by Size() and not by the null-terminator
         [[nodiscard]] const CharT* Find(StdStringViewT other, int baseOffset = 0) const noexcept
         {
-            if (!Verify(!IsEmpty() && !other.empty(), "Impossible to work with nullptr string."))
+            if (!Verify(!IsEmpty() && !other.empty(), "Impossible to work with nullptr string.") || static_cast<SizeT>(baseOffset) > _size)
             {
                 return nullptr;
             }
 
-            return Toolset::StrStr(_string + baseOffset, other.data());
+            const auto offset = Search::Find(_string + baseOffset, _size - baseOffset, other.data(), other.size());
+            return offset == Search::notFound ? nullptr : _string + baseOffset + offset;
         }
 
-        [[nodiscard]] std::vector<const CharT*> FindAll(StdStringViewT other) const noexcept
+        /// @brief overlapping occurrences are found too, the string is scanned once
+        [[nodiscard]] std::vector<const CharT*> FindAll(StdStringViewT other) const
         {
-            if (!Verify(!IsEmpty() && !other.empty(), "Impossible to work with nullptr string."))
-            {
-                return {};
-            }
-
             std::vector<const CharT*> strings;
+            IterateFind(other, [this, &strings](SizeT offset) {
+                strings.push_back(_string + offset);
+                return true;
+            });
+            return strings;
+        }
 
-            CharT* foundStr = _string;
-            do
+        [[nodiscard]] std::vector<SizeT> FindAllOffsets(StdStringViewT other) const
+        {
+            std::vector<SizeT> offsets;
+            IterateFind(other, [&offsets](SizeT offset) {
+                offsets.push_back(offset);
+                return true;
+            });
+            return offsets;
+        }
+
+        /// @brief calls the lambda with the offset of every occurrence in increasing order until it returns false
+        template<class Lambda>
+        void IterateFind(StdStringViewT other, Lambda&& lambda) const
+        {
+            if (!Verify(!IsEmpty() && !other.empty(), "Impossible to work with nullptr string."))
             {
-                if ((foundStr = Toolset::StrStr(foundStr, other.data())))
-                {
-                    strings.push_back(foundStr);
-                    ++foundStr;
-                }
-            } while (foundStr);
+                return;
+            }
 
-            return strings;
+            Search::Search(_string, _size, other.data(), other.size(), lambda);
         }
 
         BaseString() = default;
@@ -1447,8 +1311,7 @@ namespace Core
 
         BaseString(const CharT* str, SizeT size = Settings::invalidSize)
         {
-            Resize(size == Settings::invalidSize ? Toolset::Length(str) : size);
-            memcpy_s(_string, _size * sizeof(CharT), str, _size * sizeof(CharT));
+            Assign(str, size == Settings::invalidSize ? Toolset::Length(str) : size);
         }
 
         explicit BaseString(StdStringViewT str)
@@ -1456,15 +1319,26 @@ namespace Core
         {
         }
 
+        /// @brief the heap buffer is allocated from the resource, which must outlive the string. Copies of the string use
+        /// the global operator new unless they are assigned to a string with a resource.
+        explicit BaseString(std::pmr::memory_resource* resource) noexcept
+            : _resource{ resource }
+        {
+        }
+
+        BaseString(StdStringViewT str, std::pmr::memory_resource* resource)
+            : _resource{ resource }
+        {
+            Assign(str.data(), str.size());
+        }
+
         BaseString(const Self& other) { *this = other; }
 
         explicit BaseString(SizeT reserveCount) { Reserve(reserveCount); }
 
         Self& operator=(StdStringViewT other)
         {
-            Clear();
-            Resize(other.size());
-            memcpy_s(_string, _size * sizeof(CharT), other.data(), other.size() * sizeof(CharT));
+            Assign(other.data(), other.size());
             return *this;
         }
 
@@ -1477,9 +1351,14 @@ namespace Core
 
             if (other._policy == StringPolicy::Dynamic)
             {
-                Clear();
-                Resize(other._size);
-                memcpy_s(_string, _size * sizeof(CharT), other._string, other._size * sizeof(CharT));
+#ifdef CORE_STRING_COPY_ON_WRITE
+                if (!other.IsInline() && !other._isBufferLeaked && IsSameMemoryResource(other))
+                {
+                    ShareBuffer(other);
+                    return *this;
+                }
+#endif
+                Assign(other._string, other._size);
             }
             else if (other._policy == StringPolicy::Static)
             {
@@ -1488,6 +1367,11 @@ namespace Core
                 _string = other._string;
                 _size = other._size;
                 _capacity = other._capacity;
+                _entry = other._entry;
+                if (_entry)
+                {
+                    StringPool::Retain(*_entry);
+                }
             }
             else
             {
@@ -1497,14 +1381,35 @@ namespace Core
             return *this;
         }
 
-        BaseString(Self&& other) noexcept { *this = std::move(other); }
+        BaseString(Self&& other) noexcept
+            : _resource{ other._resource }
+        {
+            *this = std::move(other);
+        }
 
         Self& operator=(Self&& other) noexcept
         {
-            if (other._policy == StringPolicy::Dynamic)
+            if (other._policy == StringPolicy::Dynamic && !other.IsInline() && !IsSameMemoryResource(other))
+            {
+                // the buffer can't be given to another resource
+                *this = static_cast<const Self&>(other);
+                other.Clear();
+            }
+            else if (other._policy == StringPolicy::Dynamic)
             {
                 Clear();
-                _string = other._string;
+                if (other.IsInline())
+                {
+                    std::copy_n(other._inlineBuffer, inlineCapacity, _inlineBuffer);
+                    _string = _inlineBuffer;
+                }
+                else
+                {
+                    _string = other._string;
+#ifdef CORE_STRING_COPY_ON_WRITE
+                    _isBufferLeaked = std::exchange(other._isBufferLeaked, false);
+#endif
+                }
                 _size = other._size;
                 _policy = StringPolicy::Dynamic;
                 _capacity = other._capacity;
@@ -1521,22 +1426,28 @@ namespace Core
                 _string = other._string;
                 _size = other._size;
                 _capacity = other._capacity;
+                _entry = other._entry;
 
                 other._size = 0;
                 other._string = nullptr;
                 other._policy = StringPolicy::None;
                 other._capacity = 0;
+                other._entry = nullptr;
             }
             else
             {
                 Clear();
             }
 
+            // the moved-from string is empty, its memoized hash would make it differ from other empty strings
+            other.InvalidateHash();
             return *this;
         }
 
         void Clear()
         {
+            InvalidateHash();
+            SetBufferLeaked(false);
             if (_string)
             {
                 if (_policy == StringPolicy::Static)
@@ -1545,10 +1456,14 @@ namespace Core
                     _size = 0;
                     _policy = StringPolicy::None;
                     _capacity = 0;
+                    ReleaseEntry();
                 }
                 else if (_policy == StringPolicy::Dynamic)
                 {
-                    delete[] _string;
+                    if (!IsInline())
+                    {
+                        Deallocate(_string, _capacity);
+                    }
                     _string = nullptr;
                     _size = 0;
                     _policy = StringPolicy::None;
@@ -1561,60 +1476,52 @@ namespace Core
             }
         }
 
+        /// @brief a capacity below the current one shrinks the buffer and cuts the string to 'newSize' characters
         Self& Reserve(const SizeT newSize)
         {
-            const auto* oldString = _string;
-            const auto oldCapacity = _capacity;
-
-            const SizeT finalCapacity = newSize * _capacityMultiplier + static_cast<SizeT>(1);
-            if (auto* newString = new CharT[finalCapacity]{})
-            {
-                if (_string)
-                {
-                    const auto limit = std::min(finalCapacity, oldCapacity);
-                    for (IndexT i = 0; i < limit; ++i)
-                    {
-                        newString[i] = _string[i];
-                    }
-                }
-
-                if (_policy == StringPolicy::Static)
-                {
-                    _string = nullptr;
-                }
-                else if (_policy == StringPolicy::Dynamic)
-                {
-                    delete[] _string;
-                }
-                _string = newString;
-                _capacity = finalCapacity;
-                _policy = StringPolicy::Dynamic;
-                if (newSize < oldCapacity)
-                {
-                    _size = newSize;
-                    _string[_size] = 0;
-                }
-            }
+            InvalidateHash();
+            // short strings are kept inside the object, the inline buffer isn't grown in advance
+            const SizeT finalCapacity = newSize < inlineCapacity ? inlineCapacity : GrowthPolicy::Capacity(newSize);
+            Reallocate(finalCapacity, newSize < _capacity ? newSize : _size);
 
             return *this;
         }
 
+        /// @brief new characters are zeros. The buffer is reallocated only if the capacity isn't enough.
         Self& Resize(const SizeT newSize)
         {
-            if (newSize < _size && _policy != StringPolicy::Static)
+            InvalidateHash();
+            if (newSize >= _capacity || !IsWritable())
             {
-                _string[newSize] = 0;
+                Reallocate(newSize < inlineCapacity ? inlineCapacity : GrowthPolicy::Capacity(newSize), newSize);
+                return *this;
             }
-            else if (newSize > _size || _policy == StringPolicy::Static)
+
+            if (newSize > _size)
             {
-                Reserve(newSize);
+                std::fill(_string + _size, _string + newSize, static_cast<CharT>(0));
             }
-            // for empty init
-            else if (newSize == 0 && _policy == StringPolicy::None)
+            _size = newSize;
+            _string[_size] = 0;
+
+            return *this;
+        }
+
+        /// @brief makes the string 'size' characters long without initializing the new characters. The operation gets the
+        /// buffer and 'size', writes the characters and returns the final size (not greater than 'size'). A new buffer is
+        /// allocated with the exact size.
+        template<class Operation>
+        Self& ResizeAndOverwrite(SizeT size, Operation operation)
+        {
+            InvalidateHash();
+            if (size >= _capacity || !IsWritable())
             {
-                Reserve(1);
+                Reallocate(size < inlineCapacity ? inlineCapacity : size + static_cast<SizeT>(1), std::min(_size, size));
             }
-            _size = newSize;
+
+            const SizeT finalSize = std::invoke(std::move(operation), _string, size);
+            _size = Verify(finalSize <= size, "The operation wrote more characters than it was allowed.") ? finalSize : size;
+            _string[_size] = 0;
 
             return *this;
         }
@@ -1629,7 +1536,7 @@ namespace Core
             return temp;
         }
 
-        ~BaseString() override { Clear(); }
+        ~BaseString() { Clear(); }
 
         // ============= Utils ===============
         static std::size_t GetLinesCountInText(const Self& source, const CharT* end) noexcept
@@ -1658,16 +1565,230 @@ namespace Core
         }
 
     protected:
+        // static strings are never written, TryToMakeAsDynamic makes a copy first
         explicit BaseString(StringDataReadOnlyT data)
-            : _string{ data.str },
+            : _string{ const_cast<CharT*>(data.str) },
               _size{ data.size },
               _capacity{ data.size + static_cast<SizeT>(1) },
-              _policy{ StringPolicy::Static }
+              _policy{ StringPolicy::Static },
+              _entry{ data.entry }
         {
         }
 
+        [[nodiscard]] CharT* Allocate(SizeT capacity)
+        {
+#ifdef CORE_STRING_COPY_ON_WRITE
+            // the characters follow the count of strings which share the buffer
+            const auto bytes = sizeof(SharedCounterT) + capacity * sizeof(CharT);
+            void* memory = _resource ? _resource->allocate(bytes, alignof(SharedCounterT)) : ::operator new(bytes);
+            return reinterpret_cast<CharT*>(new (memory) SharedCounterT(1) + 1);
+#else
+            if (_resource)
+            {
+                return static_cast<CharT*>(_resource->allocate(capacity * sizeof(CharT), alignof(CharT)));
+            }
+            return new CharT[capacity];
+#endif
+        }
+
+        /// @brief a shared buffer is freed by the last string which refers to it
+        void Deallocate(CharT* string, SizeT capacity) noexcept
+        {
+#ifdef CORE_STRING_COPY_ON_WRITE
+            auto* counter = GetSharedCounter(string);
+            if (counter->fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+
+            counter->~SharedCounterT();
+            if (_resource)
+            {
+                _resource->deallocate(counter, sizeof(SharedCounterT) + capacity * sizeof(CharT), alignof(SharedCounterT));
+            }
+            else
+            {
+                ::operator delete(counter);
+            }
+#else
+            if (_resource)
+            {
+                _resource->deallocate(string, capacity * sizeof(CharT), alignof(CharT));
+            }
+            else
+            {
+                delete[] string;
+            }
+#endif
+        }
+
+#ifdef CORE_STRING_COPY_ON_WRITE
+        using SharedCounterT = std::atomic<SizeT>;
+
+        [[nodiscard]] static SharedCounterT* GetSharedCounter(const CharT* string) noexcept
+        {
+            return reinterpret_cast<SharedCounterT*>(const_cast<CharT*>(string)) - 1;
+        }
+
+        /// @brief refers to the heap buffer of 'other' instead of copying it. Both strings use equal memory resources.
+        void ShareBuffer(const Self& other) noexcept
+        {
+            GetSharedCounter(other._string)->fetch_add(1, std::memory_order_relaxed);
+            Clear();
+            _string = other._string;
+            _size = other._size;
+            _capacity = other._capacity;
+            _policy = StringPolicy::Dynamic;
+        }
+#endif
+
+        [[nodiscard]] bool IsWritable() const noexcept { return _policy == StringPolicy::Dynamic && !IsBufferShared(); }
+
+        /// @brief gives the string its own copy of a shared buffer
+        void DetachBuffer()
+        {
+            if (IsBufferShared())
+            {
+                Reallocate(_capacity, _size);
+            }
+        }
+
+        /// @brief calls the lambda with the offset and the replacement of every match of ReplaceMany from left to right
+        template<class Lambda>
+        void IterateReplacements(std::span<const Replacement> replacements, Lambda&& lambda) const
+        {
+            if (replacements.size() == 1)
+            {
+                const auto& replacement = replacements.front();
+                SizeT next = 0;
+                IterateFind(replacement.first, [&replacement, &lambda, &next](SizeT offset) {
+                    if (offset >= next)
+                    {
+                        lambda(offset, replacement);
+                        next = offset + replacement.first.size();
+                    }
+                    return true;
+                });
+                return;
+            }
+
+            // the low byte of the first characters skips the positions where none of the patterns starts
+            std::array<std::uint64_t, 4> firstChars{};
+            const auto getIndex = [](CharT ch) { return static_cast<std::make_unsigned_t<CharT>>(ch) & 0xFF; };
+            for (const auto& replacement : replacements)
+            {
+                const auto index = getIndex(replacement.first.front());
+                firstChars[index / 64] |= std::uint64_t{ 1 } << (index % 64);
+            }
+
+            const auto isFirstChar = [&firstChars, &getIndex](CharT ch) {
+                const auto index = getIndex(ch);
+                return (firstChars[index / 64] >> (index % 64)) & 1;
+            };
+            for (SizeT offset = 0; offset < _size; ++offset)
+            {
+                if (!isFirstChar(_string[offset]))
+                {
+                    continue;
+                }
+
+                for (const auto& replacement : replacements)
+                {
+                    const auto& from = replacement.first;
+                    if (from.front() == _string[offset] && from.size() <= _size - offset &&
+                        std::char_traits<CharT>::compare(_string + offset + 1, from.data() + 1, from.size() - 1) == 0)
+                    {
+                        lambda(offset, replacement);
+                        offset += from.size() - 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] static StdStringViewT ToView(const CharT* string) noexcept
+        {
+            return string ? StdStringViewT(string) : StdStringViewT();
+        }
+
+        [[nodiscard]] bool IsSameMemoryResource(const Self& other) const noexcept
+        {
+            return _resource == other._resource || (_resource && other._resource && _resource->is_equal(*other._resource));
+        }
+
+        /// @brief moves the first 'newSize' characters into a buffer of 'newCapacity' characters. The characters which
+        /// weren't in the string are zeros, the rest of the buffer isn't initialized.
+        void Reallocate(SizeT newCapacity, SizeT newSize)
+        {
+            const bool isInline = newCapacity <= inlineCapacity;
+            auto* newString = isInline ? _inlineBuffer : Allocate(newCapacity);
+            const auto copiedSize = std::min(_size, newSize);
+            if (newString != _string && copiedSize != 0)
+            {
+                memcpy_s(newString, copiedSize * sizeof(CharT), _string, copiedSize * sizeof(CharT));
+            }
+            std::fill(newString + copiedSize, newString + newSize + static_cast<SizeT>(1), static_cast<CharT>(0));
+
+            if (_policy == StringPolicy::Static)
+            {
+                ReleaseEntry();
+            }
+            else if (_policy == StringPolicy::Dynamic && !IsInline())
+            {
+                Deallocate(_string, _capacity);
+            }
+            _string = newString;
+            SetBufferLeaked(false);
+            _size = newSize;
+            _capacity = isInline ? inlineCapacity : newCapacity;
+            _policy = StringPolicy::Dynamic;
+        }
+
+        /// @brief replaces the characters, the buffer is reused if it's big enough. A new buffer has no room for appends.
+        void Assign(const CharT* str, SizeT size)
+        {
+            InvalidateHash();
+            if (size >= _capacity || !IsWritable())
+            {
+                Clear();
+                Reallocate(size < inlineCapacity ? inlineCapacity : size + static_cast<SizeT>(1), 0);
+            }
+
+            std::char_traits<CharT>::move(_string, str, size);
+            _size = size;
+            _string[_size] = 0;
+        }
+
+        /// @brief drops the reference to the pool's record, a reclaimable string can be freed afterwards
+        void ReleaseEntry() noexcept
+        {
+            if (_entry)
+            {
+                StringPool::Release(*_entry);
+                _entry = nullptr;
+            }
+        }
+
+        /// @brief see data()
+        void SetBufferLeaked([[maybe_unused]] bool isLeaked) noexcept
+        {
+#ifdef CORE_STRING_COPY_ON_WRITE
+            _isBufferLeaked = isLeaked;
+#endif
+        }
+
+        void InvalidateHash() noexcept
+        {
+#ifdef CORE_STRING_MEMOIZE_HASH
+            _hash.store(notComputedHash, std::memory_order_relaxed);
+#endif
+        }
+
+        /// @brief must be called before every modification of the characters
         void TryToMakeAsDynamic()
         {
+            InvalidateHash();
+            DetachBuffer();
             if (_policy != StringPolicy::Dynamic && !IsEmpty())
             {
                 Reserve(_size);
@@ -1679,49 +1800,243 @@ namespace Core
         SizeT _size = 0;
         SizeT _capacity = 0;
         StringPolicy _policy = StringPolicy::None;
-        static constexpr SizeT _capacityMultiplier = 2ull;
+        // the pool's record of a static string
+        const _StringPoolEntry<CharT>* _entry = nullptr;
+        // allocates the heap buffer of a dynamic string, nullptr means the global operator new
+        std::pmr::memory_resource* _resource = nullptr;
+#ifdef CORE_STRING_COPY_ON_WRITE
+        // data() gave out a mutable pointer to the heap buffer, so it's copied instead of being shared
+        bool _isBufferLeaked = false;
+#endif
+#ifdef CORE_STRING_MEMOIZE_HASH
+        // a string whose hash happens to be notComputedHash is hashed every time
+        mutable std::atomic<HashT> _hash = notComputedHash;
+#endif
+        // small-string optimization: dynamic strings shorter than the buffer don't allocate
+        CharT _inlineBuffer[inlineCapacity]{};
     };
 
     using StringAtom = BaseString<char>;
     using WStringAtom = BaseString<wchar_t>;
-} // namespace Core
+    using StringAtomPool = _StringPool<char>;
+    using WStringAtomPool = _StringPool<wchar_t>;
 
-template<class CharType>
-struct std::hash<Core::BaseString<CharType>>
-{
-    size_t operator()(const Core::BaseString<CharType>& x) const noexcept { return x.MakeHash(); }
-};
+    static_assert(IsRandomAccessIterator<StringAtom::IteratorT> && IsRandomAccessIterator<StringAtom::ReverseIteratorT>);
+    static_assert(std::is_trivially_copyable_v<StringAtom::IteratorT> && std::is_trivially_copyable_v<WStringAtom::IteratorT>);
 
-inline Core::BaseString<char> operator""_atom(const char* str, std::size_t size) noexcept
-{
-    return Core::BaseString<char>::Intern(str, size, true);
-}
+    template<class T>
+    concept IsCharacterType = std::is_same_v<T, char> || std::is_same_v<T, wchar_t>;
 
-inline Core::BaseString<wchar_t> operator""_atom(const wchar_t* str, std::size_t size) noexcept
-{
-    return Core::BaseString<wchar_t>::Intern(str, size, true);
-}
+    /// @brief a piece of StrCat and Join: a view of a string or of a character or a number formatted into the piece
+    /// itself (numbers are formatted by std::to_chars)
+    template<class CharType>
+    class _StringPiece : public Utils::NotCopyableAndNotMoveable
+    {
+    public:
+        using CharT = CharType;
+        using StdStringViewT = typename _StringToolset<CharT>::StdStringViewT;
 
-template<class CharType>
-[[nodiscard]] bool operator>(typename Core::_StringToolset<CharType>::StdStringViewT str1, const Core::BaseString<CharType>& str2)
-{
-    return !(str2 > str1);
-}
+        explicit _StringPiece(StdStringViewT string) noexcept
+            : _view{ string }
+        {
+        }
 
-template<class CharType>
-[[nodiscard]] bool operator>=(typename Core::_StringToolset<CharType>::StdStringViewT str1, const Core::BaseString<CharType>& str2)
-{
-    return !(str2 > str1) || (str1 == str2);
-}
+        explicit _StringPiece(const CharT* string) noexcept
+            : _view{ string ? StdStringViewT(string) : StdStringViewT() }
+        {
+        }
+
+        explicit _StringPiece(const BaseString<CharT>& string) noexcept
+            : _view{ string.ToStringView() }
+        {
+        }
+
+        template<IsCharacterType T>
+        explicit _StringPiece(T ch) noexcept
+        {
+            _buffer[0] = static_cast<CharT>(ch);
+            _view = StdStringViewT(_buffer, 1);
+        }
+
+        template<Utils::IsArithmetic T>
+            requires(!IsCharacterType<T> && !std::is_same_v<T, bool>)
+        explicit _StringPiece(T value) noexcept
+        {
+            char digits[bufferSize];
+            const auto result = std::to_chars(digits, digits + bufferSize, value);
+            std::copy(digits, result.ptr, _buffer);
+            _view = StdStringViewT(_buffer, result.ptr - digits);
+        }
+
+        [[nodiscard]] StdStringViewT View() const noexcept { return _view; }
+
+    private:
+        // enough for any integer and for the shortest form of any double
+        constexpr static std::size_t bufferSize = 32;
+
+        StdStringViewT _view;
+        CharT _buffer[bufferSize];
+    };
+
+    template<class T>
+    struct _StringPieceChar
+    {
+        using Type = void;
+    };
+
+    template<class CharType>
+    struct _StringPieceChar<BaseString<CharType>>
+    {
+        using Type = CharType;
+    };
+
+    template<class CharType, class Traits>
+    struct _StringPieceChar<std::basic_string_view<CharType, Traits>>
+    {
+        using Type = CharType;
+    };
+
+    template<class CharType, class Traits, class Allocator>
+    struct _StringPieceChar<std::basic_string<CharType, Traits, Allocator>>
+    {
+        using Type = CharType;
+    };
+
+    template<IsCharacterType CharType>
+    struct _StringPieceChar<CharType*>
+    {
+        using Type = CharType;
+    };
+
+    template<IsCharacterType CharType>
+    struct _StringPieceChar<const CharType*>
+    {
+        using Type = CharType;
+    };
+
+    /// @brief the character type of the first string among the pieces, char if there are only characters and numbers
+    template<class... Pieces>
+    struct _StringPiecesChar
+    {
+        using Type = char;
+    };
+
+    template<class Piece, class... Pieces>
+    struct _StringPiecesChar<Piece, Pieces...>
+    {
+        using PieceCharT = typename _StringPieceChar<std::decay_t<Piece>>::Type;
+        using Type = std::conditional_t<std::is_void_v<PieceCharT>, typename _StringPiecesChar<Pieces...>::Type, PieceCharT>;
+    };
+
+    /// @brief concatenates strings, views, characters and numbers into one allocation of the exact size. The character
+    /// type is taken from the first string unless it's given explicitly: StrCat<wchar_t>(42, L'x').
+    template<class CharType, class... Pieces>
+    [[nodiscard]] auto StrCat(const Pieces&... pieces)
+    {
+        using CharT = std::conditional_t<std::is_void_v<CharType>, typename _StringPiecesChar<Pieces...>::Type, CharType>;
+        using SizeT = typename BaseString<CharT>::SizeT;
+
+        BaseString<CharT> result;
+        if constexpr (sizeof...(Pieces) != 0)
+        {
+            const _StringPiece<CharT> views[] = { _StringPiece<CharT>(pieces)... };
+            SizeT size = 0;
+            for (const auto& view : views)
+            {
+                size += view.View().size();
+            }
+
+            result.ResizeAndOverwrite(size, [&views](CharT* data, SizeT count) {
+                for (const auto& view : views)
+                {
+                    std::char_traits<CharT>::copy(data, view.View().data(), view.View().size());
+                    data += view.View().size();
+                }
+                return count;
+            });
+        }
+
+        return result;
+    }
+
+    /// @brief joins the elements of the range with the separator into one allocation of the exact size. The elements
+    /// can be anything StrCat accepts. Numbers are formatted twice: to measure and to write them.
+    template<class CharType = void, std::ranges::forward_range Range, class Separator>
+    [[nodiscard]] auto Join(const Range& range, const Separator& separator)
+    {
+        using ElementT = std::ranges::range_value_t<Range>;
+        using CharT = std::conditional_t<std::is_void_v<CharType>, typename _StringPiecesChar<ElementT, Separator>::Type, CharType>;
+        using SizeT = typename BaseString<CharT>::SizeT;
+
+        BaseString<CharT> result;
+        if (std::ranges::empty(range))
+        {
+            return result;
+        }
+
+        const _StringPiece<CharT> separatorPiece(separator);
+        SizeT size = 0;
+        SizeT count = 0;
+        for (const auto& element : range)
+        {
+            size += _StringPiece<CharT>(element).View().size();
+            ++count;
+        }
+        size += separatorPiece.View().size() * (count - 1);
+
+        result.ResizeAndOverwrite(size, [&range, &separatorPiece](CharT* data, SizeT count) {
+            bool isFirst = true;
+            for (const auto& element : range)
+            {
+                if (!isFirst)
+                {
+                    std::char_traits<CharT>::copy(data, separatorPiece.View().data(), separatorPiece.View().size());
+                    data += separatorPiece.View().size();
+                }
+                isFirst = false;
+
+                const _StringPiece<CharT> piece(element);
+                std::char_traits<CharT>::copy(data, piece.View().data(), piece.View().size());
+                data += piece.View().size();
+            }
+            return count;
+        });
+
+        return result;
+    }
+
+    /// @brief a string literal as a template argument. Its characters have static storage duration and its hash is
+    /// computed at compile time.
+    template<class CharType, std::size_t N>
+    struct _StringLiteral
+    {
+        using CharT = CharType;
+        using Settings = _StringSettings<CharT>;
+
+        constexpr _StringLiteral(const CharT (&string)[N]) noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                data[i] = string[i];
+            }
+            hash = _StringHasher<CharT>::Hash(data, Size());
+        }
+
+        [[nodiscard]] constexpr typename Settings::SizeT Size() const noexcept { return N - 1; }
+
+        CharT data[N]{};
+        typename Settings::HashT hash = 0;
+    };
+} // namespace Core
 
 template<class CharType>
-[[nodiscard]] bool operator<(typename Core::_StringToolset<CharType>::StdStringViewT str1, const Core::BaseString<CharType>& str2)
+struct std::hash<Core::BaseString<CharType>>
 {
-    return !(str2 < str1);
-}
+    size_t operator()(const Core::BaseString<CharType>& x) const noexcept { return x.MakeHash(); }
+};
 
-template<class CharType>
-[[nodiscard]] bool operator<=(typename Core::_StringToolset<CharType>::StdStringViewT str1, const Core::BaseString<CharType>& str2)
+template<Core::_StringLiteral Literal>
+[[nodiscard]] Core::BaseString<typename std::remove_cvref_t<decltype(Literal)>::CharT> operator""_atom() noexcept
 {
-    return !(str2 < str1) || (str1 == str2);
-}
\ No newline at end of file
+    return Core::BaseString<typename std::remove_cvref_t<decltype(Literal)>::CharT>::template InternLiteral<Literal>();
+}
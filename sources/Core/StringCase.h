@@ -0,0 +1,296 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Core/StringToolset.h"
+#include "Utils/CopyableAndMoveableBehaviour.h"
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+#endif
+
+namespace Core
+{
+    /// @brief case conversion and case-insensitive comparison. A whole vector of characters is processed at once when all
+    /// of them are ASCII (AVX2 if the compiler targets it, SSE2 on x86), such vectors are converted as in the "C" locale.
+    /// A vector with any other character goes through _StringToolset per character, so the current locale is respected.
+    template<class CharType>
+    struct _StringCase : public Utils::Abstract
+    {
+        using CharT = CharType;
+        using SizeT = typename _StringSettings<CharT>::SizeT;
+        using Toolset = _StringToolset<CharT>;
+
+        static void ToUpper(CharT* string, SizeT size) noexcept { Convert<true>(string, size); }
+        static void ToLower(CharT* string, SizeT size) noexcept { Convert<false>(string, size); }
+
+        /// @brief compares the first 'size' characters as if both strings were in upper case, the characters are compared
+        /// as unsigned values like strcmp does
+        /// @return a negative value, zero or a positive value
+        [[nodiscard]] static int Compare(const CharT* first, const CharT* second, SizeT size) noexcept
+        {
+            SizeT index = 0;
+#if defined(__AVX2__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            for (; index + step <= size; index += step)
+            {
+                const auto firstBlock = Load(first + index);
+                const auto secondBlock = Load(second + index);
+                if (!IsAscii(Or(firstBlock, secondBlock)))
+                {
+                    if (const int result = CompareScalar(first + index, second + index, step); result != 0)
+                    {
+                        return result;
+                    }
+                    continue;
+                }
+
+                const auto mask = MoveMask(Equal(ChangeCase<true>(firstBlock), ChangeCase<true>(secondBlock)));
+                if (mask != fullMask)
+                {
+                    const SizeT mismatch = static_cast<SizeT>(std::countr_zero(~mask)) / sizeof(CharT);
+                    return CompareCharacters(first[index + mismatch], second[index + mismatch]);
+                }
+            }
+#endif
+            return CompareScalar(first + index, second + index, size - index);
+        }
+
+        [[nodiscard]] static bool IsEqual(const CharT* first, const CharT* second, SizeT size) noexcept
+        {
+            return Compare(first, second, size) == 0;
+        }
+
+    private:
+        using UnsignedCharT = std::make_unsigned_t<CharT>;
+
+        constexpr static UnsignedCharT asciiLimit = 0x80;
+
+        template<bool isUpper>
+        [[nodiscard]] static CharT ChangeCase(CharT ch) noexcept
+        {
+            const auto code = static_cast<UnsignedCharT>(ch);
+            if (code < asciiLimit)
+            {
+                constexpr auto from = static_cast<UnsignedCharT>(isUpper ? 'a' : 'A');
+                return static_cast<UnsignedCharT>(code - from) < 26 ? static_cast<CharT>(code ^ 0x20) : ch;
+            }
+
+            return static_cast<CharT>(isUpper ? Toolset::ToUpper(ch) : Toolset::ToLower(ch));
+        }
+
+        [[nodiscard]] static int CompareCharacters(CharT first, CharT second) noexcept
+        {
+            const auto firstCode = static_cast<UnsignedCharT>(ChangeCase<true>(first));
+            const auto secondCode = static_cast<UnsignedCharT>(ChangeCase<true>(second));
+            return firstCode < secondCode ? -1 : static_cast<int>(firstCode > secondCode);
+        }
+
+        [[nodiscard]] static int CompareScalar(const CharT* first, const CharT* second, SizeT size) noexcept
+        {
+            for (SizeT index = 0; index < size; ++index)
+            {
+                if (first[index] != second[index])
+                {
+                    if (const int result = CompareCharacters(first[index], second[index]); result != 0)
+                    {
+                        return result;
+                    }
+                }
+            }
+
+            return 0;
+        }
+
+        template<bool isUpper>
+        static void Convert(CharT* string, SizeT size) noexcept
+        {
+            SizeT index = 0;
+#if defined(__AVX2__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            for (; index + step <= size; index += step)
+            {
+                const auto block = Load(string + index);
+                if (IsAscii(block))
+                {
+                    Store(string + index, ChangeCase<isUpper>(block));
+                    continue;
+                }
+
+                for (SizeT i = index; i < index + step; ++i)
+                {
+                    string[i] = ChangeCase<isUpper>(string[i]);
+                }
+            }
+#endif
+            for (; index < size; ++index)
+            {
+                string[index] = ChangeCase<isUpper>(string[index]);
+            }
+        }
+
+#if defined(__AVX2__)
+        using VectorT = __m256i;
+
+        [[nodiscard]] static VectorT Load(const CharT* string) noexcept { return _mm256_loadu_si256(reinterpret_cast<const VectorT*>(string)); }
+        static void Store(CharT* string, VectorT vector) noexcept { _mm256_storeu_si256(reinterpret_cast<VectorT*>(string), vector); }
+        [[nodiscard]] static VectorT And(VectorT first, VectorT second) noexcept { return _mm256_and_si256(first, second); }
+        [[nodiscard]] static VectorT Or(VectorT first, VectorT second) noexcept { return _mm256_or_si256(first, second); }
+        [[nodiscard]] static VectorT Xor(VectorT first, VectorT second) noexcept { return _mm256_xor_si256(first, second); }
+        [[nodiscard]] static std::uint32_t MoveMask(VectorT vector) noexcept { return static_cast<std::uint32_t>(_mm256_movemask_epi8(vector)); }
+
+        [[nodiscard]] static VectorT Broadcast(UnsignedCharT ch) noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _mm256_set1_epi8(static_cast<char>(ch));
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                return _mm256_set1_epi16(static_cast<short>(ch));
+            }
+            else
+            {
+                return _mm256_set1_epi32(static_cast<int>(ch));
+            }
+        }
+
+        [[nodiscard]] static VectorT Equal(VectorT first, VectorT second) noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _mm256_cmpeq_epi8(first, second);
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                return _mm256_cmpeq_epi16(first, second);
+            }
+            else
+            {
+                return _mm256_cmpeq_epi32(first, second);
+            }
+        }
+
+        /// @brief signed, it's correct for the ASCII vectors only
+        [[nodiscard]] static VectorT Greater(VectorT first, VectorT second) noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _mm256_cmpgt_epi8(first, second);
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                return _mm256_cmpgt_epi16(first, second);
+            }
+            else
+            {
+                return _mm256_cmpgt_epi32(first, second);
+            }
+        }
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        using VectorT = __m128i;
+
+        [[nodiscard]] static VectorT Load(const CharT* string) noexcept { return _mm_loadu_si128(reinterpret_cast<const VectorT*>(string)); }
+        static void Store(CharT* string, VectorT vector) noexcept { _mm_storeu_si128(reinterpret_cast<VectorT*>(string), vector); }
+        [[nodiscard]] static VectorT And(VectorT first, VectorT second) noexcept { return _mm_and_si128(first, second); }
+        [[nodiscard]] static VectorT Or(VectorT first, VectorT second) noexcept { return _mm_or_si128(first, second); }
+        [[nodiscard]] static VectorT Xor(VectorT first, VectorT second) noexcept { return _mm_xor_si128(first, second); }
+        [[nodiscard]] static std::uint32_t MoveMask(VectorT vector) noexcept { return static_cast<std::uint32_t>(_mm_movemask_epi8(vector)); }
+
+        [[nodiscard]] static VectorT Broadcast(UnsignedCharT ch) noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _mm_set1_epi8(static_cast<char>(ch));
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                return _mm_set1_epi16(static_cast<short>(ch));
+            }
+            else
+            {
+                return _mm_set1_epi32(static_cast<int>(ch));
+            }
+        }
+
+        [[nodiscard]] static VectorT Equal(VectorT first, VectorT second) noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _mm_cmpeq_epi8(first, second);
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                return _mm_cmpeq_epi16(first, second);
+            }
+            else
+            {
+                return _mm_cmpeq_epi32(first, second);
+            }
+        }
+
+        /// @brief signed, it's correct for the ASCII vectors only
+        [[nodiscard]] static VectorT Greater(VectorT first, VectorT second) noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _mm_cmpgt_epi8(first, second);
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                return _mm_cmpgt_epi16(first, second);
+            }
+            else
+            {
+                return _mm_cmpgt_epi32(first, second);
+            }
+        }
+#endif
+
+#if defined(__AVX2__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        constexpr static SizeT step = sizeof(VectorT) / sizeof(CharT);
+        constexpr static std::uint32_t fullMask = sizeof(VectorT) == 32 ? ~0u : (1u << sizeof(VectorT)) - 1u;
+
+        [[nodiscard]] static bool IsAscii(VectorT vector) noexcept
+        {
+            const auto high = And(vector, Broadcast(static_cast<UnsignedCharT>(~static_cast<UnsignedCharT>(0x7F))));
+            return MoveMask(Equal(high, Broadcast(0))) == fullMask;
+        }
+
+        /// @brief flips the case of the letters of the other case, the vector must be ASCII
+        template<bool isUpper>
+        [[nodiscard]] static VectorT ChangeCase(VectorT vector) noexcept
+        {
+            const auto first = static_cast<UnsignedCharT>(isUpper ? 'a' : 'A');
+            const auto afterFirst = Greater(vector, Broadcast(static_cast<UnsignedCharT>(first - 1)));
+            const auto beforeLast = Greater(Broadcast(static_cast<UnsignedCharT>(first + 26)), vector);
+            const auto isLetter = And(afterFirst, beforeLast);
+            return Xor(vector, And(isLetter, Broadcast(0x20)));
+        }
+#endif
+    };
+} // namespace Core
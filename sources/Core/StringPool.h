@@ -0,0 +1,1059 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Core/MemoryMappedFile.h"
+#include "Core/Singleton.h"
+#include "Core/StringToolset.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <xmmintrin.h>
+#endif
+
+namespace Core
+{
+    /// @brief dense index of an interned string inside its pool. Lookup of the string by id takes O(1).
+    struct AtomId
+    {
+        using ValueT = std::uint32_t;
+        constexpr static ValueT invalidValue = ~static_cast<ValueT>(0);
+
+        [[nodiscard]] constexpr bool IsValid() const noexcept { return value != invalidValue; }
+
+        [[nodiscard]] constexpr bool operator==(const AtomId&) const noexcept = default;
+        [[nodiscard]] constexpr auto operator<=>(const AtomId&) const noexcept = default;
+
+        ValueT value = invalidValue;
+    };
+
+    static_assert(sizeof(AtomId) == sizeof(AtomId::ValueT) && std::is_trivially_copyable_v<AtomId>);
+
+    template<class CharType>
+    class _StringPool;
+
+    template<class CharType>
+    class BaseString;
+
+    template<class CharType>
+    struct _StringPoolEntry
+    {
+        using Settings = _StringSettings<CharType>;
+
+        const typename Settings::CharT* str = nullptr;
+        typename Settings::SizeT size = 0;
+        typename Settings::HashT hash = 0;
+        AtomId id;
+        /// @brief count of atoms which refer to the entry, it's used only if the entry isn't pinned
+        mutable std::atomic<std::uint32_t> refs = 0;
+        /// @brief pinned entries are never freed. Once pinned the entry stays pinned.
+        std::atomic<bool> isPinned = true;
+        /// @brief the characters were allocated only for this entry instead of the arena
+        bool isStoredOnHeap = false;
+        _StringPool<CharType>* owner = nullptr;
+    };
+
+    template<class CharType>
+    struct StringDataReadOnly
+    {
+        using Settings = _StringSettings<CharType>;
+
+        const typename Settings::CharT* str;
+        typename Settings::SizeT size = Settings::invalidSize;
+        const _StringPoolEntry<CharType>* entry = nullptr;
+    };
+
+    struct StringPoolStatistics
+    {
+        std::size_t atomsCount = 0;
+        /// @brief count of interned characters including null-terminators
+        std::size_t charsCount = 0;
+        /// @brief memory which was requested by the pool's arenas and tables
+        std::size_t reservedBytes = 0;
+        std::size_t chunksCount = 0;
+        /// @brief size of the snapshots which were loaded into the pool
+        std::size_t mappedBytes = 0;
+        /// @brief count of table slots which a lookup of an interned string checks
+        std::size_t maxProbeLength = 0;
+        double averageProbeLength = 0.0;
+    };
+
+    /// @brief counters of the calling thread only, they are shared by all pools of the same character type
+    struct StringPoolThreadCacheStatistics
+    {
+        std::size_t hitsCount = 0;
+        std::size_t missesCount = 0;
+    };
+
+    /// @brief bump allocator for interned strings. Chunks are never moved or freed until the arena is destroyed.
+    template<class CharType>
+    class _StringArena : public Utils::NotCopyableButMoveable
+    {
+    public:
+        using CharT = CharType;
+        using Settings = _StringSettings<CharT>;
+        using SizeT = typename Settings::SizeT;
+
+        // chunks grow from the minimal size to the maximal one, so small pools stay small
+        constexpr static SizeT minChunkSize = 1024 / sizeof(CharT);
+        constexpr static SizeT maxChunkSize = 64 * 1024 / sizeof(CharT);
+        // bigger strings get their own chunk to not waste the rest of the current one
+        constexpr static SizeT maxSharedSize = maxChunkSize / 8;
+
+    public:
+        /// @brief copies the string with a null-terminator into the arena
+        [[nodiscard]] CharT* Store(const CharT* string, SizeT size)
+        {
+            const SizeT required = size + static_cast<SizeT>(1);
+            CharT* destination = nullptr;
+            if (required > maxSharedSize)
+            {
+                destination = AllocateChunk(required);
+            }
+            else
+            {
+                if (required > _left)
+                {
+                    const SizeT newChunkSize = std::max(_nextChunkSize, required);
+                    _current = AllocateChunk(newChunkSize);
+                    _left = newChunkSize;
+                    _nextChunkSize = std::min(_nextChunkSize * static_cast<SizeT>(2), maxChunkSize);
+                }
+
+                destination = _current;
+                _current += required;
+                _left -= required;
+            }
+
+            memcpy(destination, string, size * sizeof(CharT));
+            destination[size] = 0;
+            _usedChars += required;
+
+            return destination;
+        }
+
+        [[nodiscard]] SizeT GetUsedChars() const noexcept { return _usedChars; }
+        [[nodiscard]] SizeT GetReservedBytes() const noexcept { return _reservedBytes; }
+        [[nodiscard]] SizeT GetChunksCount() const noexcept { return _chunks.size(); }
+
+    private:
+        [[nodiscard]] CharT* AllocateChunk(SizeT size)
+        {
+            _chunks.push_back(std::make_unique_for_overwrite<CharT[]>(size));
+            _reservedBytes += size * sizeof(CharT);
+            return _chunks.back().get();
+        }
+
+    private:
+        std::vector<std::unique_ptr<CharT[]>> _chunks;
+        CharT* _current = nullptr;
+        SizeT _left = 0;
+        SizeT _nextChunkSize = minChunkSize;
+        SizeT _usedChars = 0;
+        SizeT _reservedBytes = 0;
+    };
+
+    /// @brief append-only storage of pool entries indexed by AtomId. Segments double in size and are never moved, so
+    /// an entry can be read by its id without any lock.
+    template<class CharType>
+    class _StringPoolDirectory : public Utils::NotCopyableAndNotMoveable
+    {
+    public:
+        using CharT = CharType;
+        using Settings = _StringSettings<CharT>;
+        using SizeT = typename Settings::SizeT;
+        using EntryT = _StringPoolEntry<CharT>;
+
+        constexpr static SizeT firstSegmentBits = 10;
+        // all the segments together can address the whole range of AtomId
+        constexpr static SizeT segmentsCount = sizeof(AtomId::ValueT) * 8 - firstSegmentBits;
+
+    public:
+        _StringPoolDirectory() = default;
+
+        ~_StringPoolDirectory()
+        {
+            for (auto& segment : _segments)
+            {
+                delete[] segment.load(std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief thread-safe. The entry has to be filled before it's published to other threads.
+        [[nodiscard]] EntryT& Emplace()
+        {
+            const AtomId id{ _count.fetch_add(1, std::memory_order_relaxed) };
+            if (!Verify(id.IsValid() && id.value < GetCapacity(), "The string pool is out of atom ids."))
+            {
+                std::terminate();
+            }
+
+            const auto [segmentIndex, offset] = Locate(id);
+            EntryT* segment = _segments[segmentIndex].load(std::memory_order_acquire);
+            if (!segment)
+            {
+                auto* newSegment = new EntryT[GetSegmentSize(segmentIndex)];
+                if (_segments[segmentIndex].compare_exchange_strong(segment, newSegment, std::memory_order_acq_rel))
+                {
+                    segment = newSegment;
+                }
+                else
+                {
+                    delete[] newSegment;
+                }
+            }
+
+            EntryT& entry = segment[offset];
+            entry.id = id;
+            return entry;
+        }
+
+        [[nodiscard]] const EntryT* Find(AtomId id) const noexcept
+        {
+            if (!id.IsValid() || id.value >= _count.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+
+            const auto [segmentIndex, offset] = Locate(id);
+            const EntryT* segment = _segments[segmentIndex].load(std::memory_order_acquire);
+            return segment ? segment + offset : nullptr;
+        }
+
+        [[nodiscard]] SizeT Size() const noexcept { return _count.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] SizeT GetReservedBytes() const noexcept
+        {
+            SizeT bytes = 0;
+            for (SizeT i = 0; i < segmentsCount; ++i)
+            {
+                if (_segments[i].load(std::memory_order_relaxed))
+                {
+                    bytes += GetSegmentSize(i) * sizeof(EntryT);
+                }
+            }
+
+            return bytes;
+        }
+
+    private:
+        [[nodiscard]] constexpr static SizeT GetSegmentSize(SizeT segmentIndex) noexcept { return static_cast<SizeT>(1) << (firstSegmentBits + segmentIndex); }
+
+        [[nodiscard]] constexpr static SizeT GetCapacity() noexcept { return ((static_cast<SizeT>(1) << segmentsCount) - 1) << firstSegmentBits; }
+
+        [[nodiscard]] constexpr static std::pair<SizeT, SizeT> Locate(AtomId id) noexcept
+        {
+            // segment k starts at (2^k - 1) * 2^firstSegmentBits
+            const auto segmentIndex = static_cast<SizeT>(std::bit_width((static_cast<SizeT>(id.value) >> firstSegmentBits) + 1) - 1);
+            const auto segmentStart = ((static_cast<SizeT>(1) << segmentIndex) - 1) << firstSegmentBits;
+            return { segmentIndex, static_cast<SizeT>(id.value) - segmentStart };
+        }
+
+    private:
+        std::array<std::atomic<EntryT*>, segmentsCount> _segments{};
+        std::atomic<AtomId::ValueT> _count = 0;
+    };
+
+    /// @brief open addressing table with linear probing. Keeps the full hash and the size of every string, so
+    /// the characters are compared only for the slots whose hash matched. Not thread-safe.
+    template<class CharType>
+    class _StringPoolTable : public Utils::NotCopyableButMoveable
+    {
+    public:
+        using CharT = CharType;
+        using Settings = _StringSettings<CharT>;
+        using SizeT = typename Settings::SizeT;
+        using HashT = typename Settings::HashT;
+        using IndexT = typename Settings::IndexT;
+        using EntryT = _StringPoolEntry<CharT>;
+
+        struct Slot
+        {
+            HashT hash = 0;
+            const EntryT* entry = nullptr;
+
+            [[nodiscard]] bool IsEmpty() const noexcept { return entry == nullptr; }
+        };
+
+        constexpr static SizeT minCapacity = 16;
+
+    public:
+        [[nodiscard]] const EntryT* Find(const CharT* string, SizeT size, HashT hash) const noexcept
+        {
+            if (_count == 0)
+            {
+                return nullptr;
+            }
+
+            for (IndexT index = GetIdealIndex(hash);; index = (index + 1) & _mask)
+            {
+                const Slot& slot = _slots[index];
+                if (slot.IsEmpty())
+                {
+                    return nullptr;
+                }
+
+                if (slot.hash == hash && slot.entry->size == size && memcmp(slot.entry->str, string, size * sizeof(CharT)) == 0)
+                {
+                    return slot.entry;
+                }
+            }
+        }
+
+        /// @brief the string must not be in the table yet
+        void Insert(const EntryT& entry)
+        {
+            // keep the load factor under 3/4 to have short probe sequences
+            if ((_count + 1) * 4 > _slots.size() * 3)
+            {
+                Rehash(std::max(minCapacity, _slots.size() * 2));
+            }
+
+            ++_count;
+            Place(Slot{ entry.hash, &entry });
+        }
+
+        /// @brief hints the CPU to load the first slot which a lookup of the hash will check
+        void Prefetch(HashT hash) const noexcept
+        {
+            if (!_slots.empty())
+            {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+                _mm_prefetch(reinterpret_cast<const char*>(&_slots[GetIdealIndex(hash)]), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+                __builtin_prefetch(&_slots[GetIdealIndex(hash)]);
+#endif
+            }
+        }
+
+        /// @brief the entry must be in the table
+        void Erase(const EntryT& entry) noexcept
+        {
+            IndexT index = GetIdealIndex(entry.hash);
+            while (_slots[index].entry != &entry)
+            {
+                index = (index + 1) & _mask;
+            }
+
+            // backward shift deletion: the following slots of the cluster are moved closer to their ideal places,
+            // so lookups don't need tombstones
+            for (IndexT next = (index + 1) & _mask; !_slots[next].IsEmpty() && GetProbeLength(next) > 1; next = (next + 1) & _mask)
+            {
+                _slots[index] = _slots[next];
+                index = next;
+            }
+
+            _slots[index] = Slot{};
+            --_count;
+        }
+
+        [[nodiscard]] SizeT Size() const noexcept { return _count; }
+        [[nodiscard]] SizeT Capacity() const noexcept { return _slots.size(); }
+
+        /// @return count of slots which a lookup of the slot at the index has to check
+        [[nodiscard]] SizeT GetProbeLength(IndexT index) const noexcept { return ((index - GetIdealIndex(_slots[index].hash)) & _mask) + 1; }
+
+        template<class Func>
+        void ForEach(Func&& func) const
+        {
+            for (IndexT index = 0; index < _slots.size(); ++index)
+            {
+                if (!_slots[index].IsEmpty())
+                {
+                    std::invoke(func, _slots[index], index);
+                }
+            }
+        }
+
+    private:
+        [[nodiscard]] IndexT GetIdealIndex(HashT hash) const noexcept
+        {
+            // fibonacci hashing: the high bits of the product depend on all bits of the hash
+            constexpr HashT multiplier = sizeof(HashT) == 8 ? static_cast<HashT>(0x9E3779B97F4A7C15ull) : static_cast<HashT>(0x9E3779B9u);
+            return static_cast<IndexT>((hash * multiplier) >> _shift);
+        }
+
+        void Place(const Slot& newSlot) noexcept
+        {
+            IndexT index = GetIdealIndex(newSlot.hash);
+            while (!_slots[index].IsEmpty())
+            {
+                index = (index + 1) & _mask;
+            }
+
+            _slots[index] = newSlot;
+        }
+
+        void Rehash(SizeT newCapacity)
+        {
+            std::vector<Slot> oldSlots(newCapacity);
+            oldSlots.swap(_slots);
+            _mask = newCapacity - 1;
+            _shift = static_cast<SizeT>(sizeof(HashT) * 8 - std::countr_zero(newCapacity));
+
+            for (const Slot& slot : oldSlots)
+            {
+                if (!slot.IsEmpty())
+                {
+                    Place(slot);
+                }
+            }
+        }
+
+    private:
+        std::vector<Slot> _slots;
+        SizeT _count = 0;
+        SizeT _mask = 0;
+        SizeT _shift = 0;
+    };
+
+    /// @brief direct-mapped cache of recently interned strings which is owned by a single thread, so lookups of hot strings
+    /// don't touch the shared state of the pool. Slots are tagged by the unique id of the pool, so a destroyed pool can't be hit.
+    template<class CharType>
+    class _StringPoolThreadCache : public Utils::NotCopyableAndNotMoveable
+    {
+    public:
+        using CharT = CharType;
+        using Settings = _StringSettings<CharT>;
+        using SizeT = typename Settings::SizeT;
+        using HashT = typename Settings::HashT;
+        using EntryT = _StringPoolEntry<CharT>;
+
+#ifdef CORE_STRING_POOL_THREAD_CACHE_BITS
+        constexpr static SizeT slotsBits = CORE_STRING_POOL_THREAD_CACHE_BITS;
+#else
+        constexpr static SizeT slotsBits = 8;
+#endif
+        constexpr static SizeT slotsCount = static_cast<SizeT>(1) << slotsBits;
+
+    public:
+        [[nodiscard]] static _StringPoolThreadCache& Instance() noexcept
+        {
+            thread_local _StringPoolThreadCache cache;
+            return cache;
+        }
+
+        [[nodiscard]] const EntryT* Find(std::uint64_t poolUid, const CharT* string, SizeT size, HashT hash) noexcept
+        {
+            const Slot& slot = _slots[hash & (slotsCount - 1)];
+            if (slot.poolUid == poolUid && slot.hash == hash && slot.entry->size == size &&
+                memcmp(slot.entry->str, string, size * sizeof(CharT)) == 0)
+            {
+                ++_statistics.hitsCount;
+                return slot.entry;
+            }
+
+            ++_statistics.missesCount;
+            return nullptr;
+        }
+
+        void Put(std::uint64_t poolUid, const EntryT& entry) noexcept { _slots[entry.hash & (slotsCount - 1)] = Slot{ poolUid, entry.hash, &entry }; }
+
+        [[nodiscard]] const StringPoolThreadCacheStatistics& GetStatistics() const noexcept { return _statistics; }
+        void ResetStatistics() noexcept { _statistics = {}; }
+
+    private:
+        _StringPoolThreadCache() = default;
+
+        struct Slot
+        {
+            // ids of pools start from 1, so empty slots never match
+            std::uint64_t poolUid = 0;
+            HashT hash = 0;
+            const EntryT* entry = nullptr;
+        };
+
+    private:
+        std::array<Slot, slotsCount> _slots{};
+        StringPoolThreadCacheStatistics _statistics;
+    };
+
+    template<class CharType>
+    class _StringPool : public Singleton<_StringPool<CharType>, Utils::NotCopyableAndNotMoveable>
+    {
+    public:
+        using CharT = CharType;
+        using Toolset = _StringToolset<CharT>;
+        using StdStringViewT = typename Toolset::StdStringViewT;
+        using Settings = _StringSettings<CharT>;
+        using HashT = typename Settings::HashT;
+        using SizeT = typename Settings::SizeT;
+        using StringDataReadOnlyT = StringDataReadOnly<CharT>;
+        using TableT = _StringPoolTable<CharT>;
+        using EntryT = _StringPoolEntry<CharT>;
+        using HasherT = _StringHasher<CharT>;
+        using ThreadCacheT = _StringPoolThreadCache<CharT>;
+
+        constexpr static SizeT shardsBits = 6;
+        constexpr static SizeT shardsCount = static_cast<SizeT>(1) << shardsBits;
+        constexpr static SizeT defaultCollectThreshold = 1024;
+
+        // literals are interned with the hashes computed at compile time
+        friend class BaseString<CharT>;
+
+    public:
+        ~_StringPool()
+        {
+            for (Shard& shard : _shards)
+            {
+                shard.strings.ForEach([](const auto& slot, auto) {
+                    if (slot.entry->isStoredOnHeap)
+                    {
+                        delete[] slot.entry->str;
+                    }
+                });
+            }
+        }
+
+        /// @brief thread-safe. Lookups of already interned strings take only a shared lock of a single shard. For a reclaimable
+        /// pool the returned entry is referenced once on behalf of the caller (see Release), BaseString adopts this reference.
+        /// @param isCompileTime the string is null-terminated and has static storage duration (e.g. it's a literal),
+        /// so the pool keeps the pointer itself instead of a copy.
+        [[nodiscard]] StringDataReadOnlyT Add(const CharT* string, typename Settings::SizeT size, bool isCompileTime = false)
+        {
+            return AddWithHash(string, size, HasherT::Hash(string, size), isCompileTime);
+        }
+
+        /// @brief strings which are interned into a reclaimable pool are freed by Collect once no atom refers to them.
+        /// Strings which were interned before, compile-time strings and snapshots stay pinned. Disabled by default.
+        void SetReclaimable(bool isReclaimable) noexcept { _isReclaimable.store(isReclaimable, std::memory_order_relaxed); }
+        [[nodiscard]] bool IsReclaimable() const noexcept { return _isReclaimable.load(std::memory_order_relaxed); }
+
+        /// @brief count of released strings after which Collect is called automatically, 0 disables it
+        void SetCollectThreshold(SizeT threshold) noexcept { _collectThreshold.store(threshold, std::memory_order_relaxed); }
+
+        static void Retain(const EntryT& entry) noexcept
+        {
+            if (!entry.isPinned.load(std::memory_order_relaxed))
+            {
+                entry.refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        static void Release(const EntryT& entry) noexcept
+        {
+            if (entry.isPinned.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            // the entry can be freed and reused by another thread as soon as the reference is dropped
+            auto* owner = entry.owner;
+            if (entry.refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                owner->OnUnreferenced();
+            }
+        }
+
+        /// @brief frees all strings of the reclaimable pool which aren't referred by any atom. Their ids are reused.
+        /// @return count of freed strings
+        SizeT Collect()
+        {
+            _unreferencedCount.store(0, std::memory_order_relaxed);
+
+            SizeT count = 0;
+            std::vector<const EntryT*> garbage;
+            for (Shard& shard : _shards)
+            {
+                // lookups take a reference under a shard lock, so no one can revive an entry while the lock is exclusive
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                garbage.clear();
+                shard.strings.ForEach([&garbage](const auto& slot, auto) {
+                    if (!slot.entry->isPinned.load(std::memory_order_relaxed) && slot.entry->refs.load(std::memory_order_acquire) == 0)
+                    {
+                        garbage.push_back(slot.entry);
+                    }
+                });
+
+                for (const EntryT* entry : garbage)
+                {
+                    shard.strings.Erase(*entry);
+                    FreeEntry(const_cast<EntryT&>(*entry));
+                }
+                count += garbage.size();
+            }
+
+            return count;
+        }
+
+        /// @brief repeated interning of the same strings by a thread is resolved by a small per-thread cache
+        /// without locking the shards. Disabled by default.
+        void SetThreadCacheEnabled(bool isEnabled) noexcept { _isThreadCacheEnabled.store(isEnabled, std::memory_order_relaxed); }
+        [[nodiscard]] bool IsThreadCacheEnabled() const noexcept { return _isThreadCacheEnabled.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] static StringPoolThreadCacheStatistics GetThreadCacheStatistics() noexcept { return ThreadCacheT::Instance().GetStatistics(); }
+        static void ResetThreadCacheStatistics() noexcept { ThreadCacheT::Instance().ResetStatistics(); }
+
+        /// @brief the same as Add for many strings at once. All hashes are computed up front, then every touched shard is
+        /// locked only once while its strings are looked up or inserted, the table slots are prefetched ahead of the probes.
+        /// @param out receives the interned strings in the order of the input, it must have the same size
+        void AddBatch(std::span<const StdStringViewT> strings, std::span<StringDataReadOnlyT> out)
+        {
+            if (!Verify(strings.size() == out.size(), "The output must have the same size as the input."))
+            {
+                return;
+            }
+
+            std::vector<HashT> hashes(strings.size());
+            // the indices of the strings grouped by their shards (counting sort)
+            std::vector<SizeT> order(strings.size());
+            std::array<SizeT, shardsCount + 1> shardOffsets{};
+            for (SizeT i = 0; i < strings.size(); ++i)
+            {
+                hashes[i] = HasherT::Hash(strings[i].data(), strings[i].size());
+                ++shardOffsets[GetShardIndex(hashes[i]) + 1];
+            }
+            for (SizeT i = 1; i <= shardsCount; ++i)
+            {
+                shardOffsets[i] += shardOffsets[i - 1];
+            }
+            {
+                auto positions = shardOffsets;
+                for (SizeT i = 0; i < strings.size(); ++i)
+                {
+                    order[positions[GetShardIndex(hashes[i])]++] = i;
+                }
+            }
+
+            constexpr SizeT prefetchDistance = 8;
+            for (SizeT shardIndex = 0; shardIndex < shardsCount; ++shardIndex)
+            {
+                const SizeT first = shardOffsets[shardIndex];
+                const SizeT last = shardOffsets[shardIndex + 1];
+                if (first == last)
+                {
+                    continue;
+                }
+
+                Shard& shard = _shards[shardIndex];
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                for (SizeT i = first; i < std::min(last, first + prefetchDistance); ++i)
+                {
+                    shard.strings.Prefetch(hashes[order[i]]);
+                }
+
+                for (SizeT i = first; i < last; ++i)
+                {
+                    if (i + prefetchDistance < last)
+                    {
+                        shard.strings.Prefetch(hashes[order[i + prefetchDistance]]);
+                    }
+
+                    const SizeT index = order[i];
+                    out[index] = ToReadOnly(FindOrInsertLocked(shard, strings[index].data(), strings[index].size(), hashes[index], false));
+                }
+            }
+        }
+
+        /// @brief thread-safe and lock-free. The id must be taken from an atom of this pool. Ids of reclaimable strings
+        /// are valid only while some atom refers to the string, afterwards the id can be reused by another string.
+        [[nodiscard]] StringDataReadOnlyT Resolve(AtomId id) const noexcept
+        {
+            if (const auto* entry = _entries.Find(id); entry && entry->str)
+            {
+                return ToReadOnly(*entry);
+            }
+
+            return StringDataReadOnlyT{ nullptr, 0 };
+        }
+
+        [[nodiscard]] StdStringViewT GetView(AtomId id) const noexcept
+        {
+            const auto data = Resolve(id);
+            return data.str ? StdStringViewT{ data.str, data.size } : StdStringViewT{};
+        }
+
+        /// @brief writes all interned strings with their hashes to a file which can be loaded by LoadSnapshot on the next start.
+        /// Reclaimable strings which no atom refers to are skipped. Strings are written in the order of their ids, so a fresh
+        /// pool gets the same ids after loading unless some ids were freed: the ids aren't stored and the gaps are closed.
+        bool SaveSnapshot(const std::filesystem::path& path) const
+        {
+            // Collect can't free the strings while the shards are locked, so they stay locked until the file is written
+            struct SavedEntry
+            {
+                AtomId id;
+                HashT hash;
+                SizeT size;
+                const CharT* str;
+            };
+
+            std::array<std::shared_lock<std::shared_mutex>, shardsCount> locks;
+            std::vector<SavedEntry> entries;
+            for (SizeT i = 0; i < shardsCount; ++i)
+            {
+                locks[i] = std::shared_lock<std::shared_mutex>(_shards[i].mutex);
+                _shards[i].strings.ForEach([&entries](const auto& slot, auto) {
+                    const EntryT& entry = *slot.entry;
+                    if (entry.isPinned.load(std::memory_order_relaxed) || entry.refs.load(std::memory_order_acquire) != 0)
+                    {
+                        entries.push_back(SavedEntry{ entry.id, entry.hash, entry.size, entry.str });
+                    }
+                });
+            }
+            std::sort(entries.begin(), entries.end(), [](const SavedEntry& lhs, const SavedEntry& rhs) { return lhs.id < rhs.id; });
+
+            SnapshotHeader header{ snapshotMagic, snapshotVersion, sizeof(CharT), sizeof(HashT), entries.size(), 0 };
+            std::vector<SnapshotRecord> records;
+            records.reserve(entries.size());
+            for (const SavedEntry& entry : entries)
+            {
+                records.push_back(SnapshotRecord{ entry.hash, header.charsCount, entry.size });
+                header.charsCount += entry.size + 1;
+            }
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(SnapshotRecord)));
+            for (const SavedEntry& entry : entries)
+            {
+                // every interned string is null-terminated
+                file.write(reinterpret_cast<const char*>(entry.str), static_cast<std::streamsize>((entry.size + 1) * sizeof(CharT)));
+            }
+
+            return static_cast<bool>(file);
+        }
+
+        /// @brief maps a file written by SaveSnapshot into the memory. Strings are adopted in place with their stored hashes,
+        /// so nothing is hashed or copied; the mapping lives as long as the pool. Strings which are already interned are skipped.
+        /// @return false if the file doesn't exist or isn't a snapshot for this pool, the pool stays untouched in that case
+        bool LoadSnapshot(const std::filesystem::path& path)
+        {
+            MemoryMappedFile file(path);
+            if (!file.IsOpen() || file.Size() < sizeof(SnapshotHeader))
+            {
+                return false;
+            }
+
+            SnapshotHeader header;
+            memcpy(&header, file.Data(), sizeof(header));
+            if (header.magic != snapshotMagic || header.version != snapshotVersion || header.charSize != sizeof(CharT) ||
+                header.hashSize != sizeof(HashT))
+            {
+                return false;
+            }
+
+            const std::uint64_t bodySize = file.Size() - sizeof(SnapshotHeader);
+            if (header.stringsCount > bodySize / sizeof(SnapshotRecord) || header.charsCount > bodySize / sizeof(CharT) ||
+                header.stringsCount * sizeof(SnapshotRecord) + header.charsCount * sizeof(CharT) != bodySize)
+            {
+                return false;
+            }
+
+            // the mapping is page aligned and the header and records keep the alignment of the following data
+            const auto* records = reinterpret_cast<const SnapshotRecord*>(file.Data() + sizeof(SnapshotHeader));
+            const auto* chars = reinterpret_cast<const CharT*>(records + header.stringsCount);
+            for (std::uint64_t i = 0; i < header.stringsCount; ++i)
+            {
+                const SnapshotRecord& record = records[i];
+                if (record.offset >= header.charsCount || record.size >= header.charsCount - record.offset ||
+                    chars[record.offset + record.size] != static_cast<CharT>(0))
+                {
+                    return false;
+                }
+            }
+
+            std::array<std::unique_lock<std::shared_mutex>, shardsCount> locks;
+            for (SizeT i = 0; i < shardsCount; ++i)
+            {
+                locks[i] = std::unique_lock<std::shared_mutex>(_shards[i].mutex);
+            }
+
+            for (std::uint64_t i = 0; i < header.stringsCount; ++i)
+            {
+                const SnapshotRecord& record = records[i];
+                const CharT* string = chars + record.offset;
+                const auto size = static_cast<SizeT>(record.size);
+                const auto hash = static_cast<HashT>(record.hash);
+
+                Shard& shard = GetShard(hash);
+                if (shard.strings.Find(string, size, hash))
+                {
+                    continue;
+                }
+
+                EntryT& entry = AcquireEntry();
+                entry.str = string;
+                entry.size = size;
+                entry.hash = hash;
+                entry.owner = this;
+                entry.isStoredOnHeap = false;
+                entry.isPinned.store(true, std::memory_order_relaxed);
+                shard.strings.Insert(entry);
+            }
+
+            // all the shards are locked, so the snapshots are guarded as well
+            _snapshots.push_back(std::move(file));
+            return true;
+        }
+
+        [[nodiscard]] StringPoolStatistics GetStatistics() const
+        {
+            StringPoolStatistics statistics;
+            SizeT probesSum = 0;
+            for (const Shard& shard : _shards)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                if (&shard == &_shards.front())
+                {
+                    // LoadSnapshot adds the snapshots under the locks of all the shards, so any one of them guards the list
+                    for (const MemoryMappedFile& snapshot : _snapshots)
+                    {
+                        statistics.mappedBytes += snapshot.Size();
+                    }
+                }
+
+                statistics.atomsCount += shard.strings.Size();
+                statistics.charsCount += shard.arena.GetUsedChars();
+                statistics.reservedBytes += shard.arena.GetReservedBytes() + shard.strings.Capacity() * sizeof(typename TableT::Slot);
+                statistics.chunksCount += shard.arena.GetChunksCount();
+                shard.strings.ForEach([&statistics, &shard, &probesSum](const auto&, auto index) {
+                    const auto probeLength = shard.strings.GetProbeLength(index);
+                    statistics.maxProbeLength = std::max(statistics.maxProbeLength, probeLength);
+                    probesSum += probeLength;
+                });
+            }
+
+            statistics.reservedBytes += _entries.GetReservedBytes();
+            if (statistics.atomsCount != 0)
+            {
+                statistics.averageProbeLength = static_cast<double>(probesSum) / static_cast<double>(statistics.atomsCount);
+            }
+
+            return statistics;
+        }
+
+    protected:
+        /// @brief the same as Add, but for a hash which was already computed by HasherT, e.g. at compile time for a literal.
+        /// A wrong hash puts a second record of the same string into the pool, its atom isn't equal to the atom made by Add.
+        [[nodiscard]] StringDataReadOnlyT AddWithHash(const CharT* string, SizeT size, HashT hash, bool isCompileTime = false)
+        {
+            if (!_isThreadCacheEnabled.load(std::memory_order_relaxed))
+            {
+                return ToReadOnly(FindOrInsert(string, size, hash, isCompileTime));
+            }
+
+            ThreadCacheT& cache = ThreadCacheT::Instance();
+            if (const auto* entry = cache.Find(_uid, string, size, hash))
+            {
+                return ToReadOnly(*entry);
+            }
+
+            const EntryT& entry = FindOrInsert(string, size, hash, isCompileTime);
+            // the cache doesn't hold references, so only entries which are never freed can be put there
+            if (entry.isPinned.load(std::memory_order_relaxed))
+            {
+                cache.Put(_uid, entry);
+            }
+            return ToReadOnly(entry);
+        }
+
+    private:
+        constexpr static SizeT cacheLineSize = 64;
+        constexpr static std::uint32_t snapshotMagic = 0x50535355; // "USSP"
+        // has to be changed together with the layout of the snapshot or with the hash function
+        constexpr static std::uint32_t snapshotVersion = 1;
+
+        struct SnapshotHeader
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t charSize;
+            std::uint32_t hashSize;
+            std::uint64_t stringsCount;
+            std::uint64_t charsCount;
+        };
+
+        struct SnapshotRecord
+        {
+            std::uint64_t hash;
+            /// @brief index of the first character in the characters block
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+        static_assert(sizeof(SnapshotHeader) % alignof(SnapshotRecord) == 0 && sizeof(SnapshotRecord) % alignof(CharT) == 0);
+
+        struct alignas(cacheLineSize) Shard
+        {
+            mutable std::shared_mutex mutex;
+            TableT strings;
+            _StringArena<CharT> arena;
+        };
+
+        [[nodiscard]] const EntryT& FindOrInsert(const CharT* string, SizeT size, HashT hash, bool isCompileTime)
+        {
+            Shard& shard = GetShard(hash);
+
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                if (const auto* entry = shard.strings.Find(string, size, hash))
+                {
+                    return Adopt(*entry, isCompileTime);
+                }
+            }
+
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            // some other thread could add the same string while we were waiting for the exclusive lock
+            return FindOrInsertLocked(shard, string, size, hash, isCompileTime);
+        }
+
+        /// @brief has to be called under the exclusive lock of the shard
+        [[nodiscard]] const EntryT& FindOrInsertLocked(Shard& shard, const CharT* string, SizeT size, HashT hash, bool isCompileTime)
+        {
+            if (const auto* entry = shard.strings.Find(string, size, hash))
+            {
+                return Adopt(*entry, isCompileTime);
+            }
+
+            const bool isPinned = isCompileTime || !_isReclaimable.load(std::memory_order_relaxed);
+            EntryT& entry = AcquireEntry();
+            entry.isStoredOnHeap = !isPinned;
+            if (isCompileTime)
+            {
+                entry.str = string;
+            }
+            else if (isPinned)
+            {
+                entry.str = shard.arena.Store(string, size);
+            }
+            else
+            {
+                // an arena can't free a single string
+                auto* newString = new CharT[size + 1];
+                std::copy_n(string, size, newString);
+                newString[size] = 0;
+                entry.str = newString;
+            }
+            entry.size = size;
+            entry.hash = hash;
+            entry.owner = this;
+            entry.refs.store(isPinned ? 0 : 1, std::memory_order_relaxed);
+            entry.isPinned.store(isPinned, std::memory_order_relaxed);
+            shard.strings.Insert(entry);
+
+            return entry;
+        }
+
+        /// @brief has to be called under a lock of the entry's shard
+        [[nodiscard]] static const EntryT& Adopt(const EntryT& entry, bool isCompileTime) noexcept
+        {
+            if (isCompileTime)
+            {
+                // compile-time strings are cached by their users forever
+                const_cast<EntryT&>(entry).isPinned.store(true, std::memory_order_relaxed);
+            }
+            Retain(entry);
+            return entry;
+        }
+
+        [[nodiscard]] EntryT& AcquireEntry()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_freeIdsMutex);
+                if (!_freeIds.empty())
+                {
+                    const AtomId id = _freeIds.back();
+                    _freeIds.pop_back();
+                    return const_cast<EntryT&>(*_entries.Find(id));
+                }
+            }
+
+            return _entries.Emplace();
+        }
+
+        void FreeEntry(EntryT& entry)
+        {
+            delete[] entry.str;
+            entry.str = nullptr;
+            entry.size = 0;
+
+            std::lock_guard<std::mutex> lock(_freeIdsMutex);
+            _freeIds.push_back(entry.id);
+        }
+
+        void OnUnreferenced()
+        {
+            const SizeT threshold = _collectThreshold.load(std::memory_order_relaxed);
+            if (threshold != 0 && _unreferencedCount.fetch_add(1, std::memory_order_relaxed) + 1 >= threshold)
+            {
+                Collect();
+            }
+        }
+
+        [[nodiscard]] static std::uint64_t MakeUid() noexcept
+        {
+            static std::atomic<std::uint64_t> lastUid = 0;
+            return lastUid.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        [[nodiscard]] static StringDataReadOnlyT ToReadOnly(const EntryT& entry) noexcept { return StringDataReadOnlyT{ entry.str, entry.size, &entry }; }
+
+        [[nodiscard]] Shard& GetShard(HashT hash) noexcept { return _shards[GetShardIndex(hash)]; }
+
+        [[nodiscard]] constexpr static SizeT GetShardIndex(HashT hash) noexcept
+        {
+            // the shard's table takes its index from the whole hash, so the high bits are free to be used here
+            return static_cast<SizeT>(hash >> (sizeof(HashT) * 8 - shardsBits));
+        }
+
+    private:
+        std::array<Shard, shardsCount> _shards;
+        _StringPoolDirectory<CharT> _entries;
+        std::vector<MemoryMappedFile> _snapshots;
+        const std::uint64_t _uid = MakeUid();
+        std::atomic<bool> _isThreadCacheEnabled = false;
+        std::atomic<bool> _isReclaimable = false;
+        std::atomic<SizeT> _collectThreshold = defaultCollectThreshold;
+        std::atomic<SizeT> _unreferencedCount = 0;
+        std::mutex _freeIdsMutex;
+        std::vector<AtomId> _freeIds;
+    };
+} // namespace Core
+
+template<>
+struct std::hash<Core::AtomId>
+{
+    size_t operator()(const Core::AtomId& x) const noexcept { return std::hash<Core::AtomId::ValueT>{}(x.value); }
+};
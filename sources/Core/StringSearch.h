@@ -0,0 +1,218 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Core/StringToolset.h"
+#include "Utils/CopyableAndMoveableBehaviour.h"
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+#endif
+
+namespace Core
+{
+    /// @brief length-aware substring search, the characters may contain zeros. A whole vector of positions is checked at
+    /// once by comparing the first and the last character of the needle (AVX2 if the compiler targets it, SSE2 on x86),
+    /// only the positions where both match are compared completely. Other targets use a memchr-like scalar search.
+    template<class CharType>
+    struct _StringSearch : public Utils::Abstract
+    {
+        using CharT = CharType;
+        using SizeT = typename _StringSettings<CharT>::SizeT;
+        using Traits = std::char_traits<CharT>;
+
+        constexpr static SizeT notFound = _StringSettings<CharT>::invalidSize;
+
+        /// @brief calls the lambda with the offset of every occurrence of the needle (overlapping ones too) in increasing
+        /// order, it stops when the lambda returns false. The haystack is scanned once.
+        template<class Lambda>
+        static void Search(const CharT* haystack, SizeT size, const CharT* needle, SizeT needleSize, Lambda&& lambda)
+        {
+            if (needleSize == 0 || needleSize > size)
+            {
+                return;
+            }
+
+            if (needleSize == 1)
+            {
+                const CharT* last = haystack + size;
+                for (const CharT* found = haystack; (found = Traits::find(found, last - found, needle[0])); ++found)
+                {
+                    if (!lambda(static_cast<SizeT>(found - haystack)))
+                    {
+                        return;
+                    }
+                }
+                return;
+            }
+
+            SizeT offset = 0;
+            if (!SearchVectorized(haystack, size, needle, needleSize, offset, lambda))
+            {
+                return;
+            }
+
+            // the positions which are left after the last whole vector
+            for (const SizeT lastOffset = size - needleSize; offset <= lastOffset; ++offset)
+            {
+                if (haystack[offset] == needle[0] && IsMatch(haystack + offset, needle, needleSize) && !lambda(offset))
+                {
+                    return;
+                }
+            }
+        }
+
+        [[nodiscard]] static SizeT Find(const CharT* haystack, SizeT size, const CharT* needle, SizeT needleSize) noexcept
+        {
+            SizeT result = notFound;
+            Search(haystack, size, needle, needleSize, [&result](SizeT offset) {
+                result = offset;
+                return false;
+            });
+            return result;
+        }
+
+    private:
+        [[nodiscard]] static bool IsMatch(const CharT* string, const CharT* needle, SizeT needleSize) noexcept
+        {
+            return string[needleSize - 1] == needle[needleSize - 1] && Traits::compare(string + 1, needle + 1, needleSize - 2) == 0;
+        }
+
+#if defined(__AVX2__)
+        using VectorT = __m256i;
+
+        [[nodiscard]] static VectorT Broadcast(CharT ch) noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _mm256_set1_epi8(static_cast<char>(ch));
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                return _mm256_set1_epi16(static_cast<short>(ch));
+            }
+            else
+            {
+                return _mm256_set1_epi32(static_cast<int>(ch));
+            }
+        }
+
+        /// @brief a bit per byte of the vector, the bits of every character are set if both vectors have it at this position
+        [[nodiscard]] static std::uint32_t MatchMask(VectorT first, VectorT last, const CharT* blockFirst, const CharT* blockLast) noexcept
+        {
+            const auto loadedFirst = _mm256_loadu_si256(reinterpret_cast<const VectorT*>(blockFirst));
+            const auto loadedLast = _mm256_loadu_si256(reinterpret_cast<const VectorT*>(blockLast));
+            VectorT equal;
+            if constexpr (sizeof(CharT) == 1)
+            {
+                equal = _mm256_and_si256(_mm256_cmpeq_epi8(first, loadedFirst), _mm256_cmpeq_epi8(last, loadedLast));
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                equal = _mm256_and_si256(_mm256_cmpeq_epi16(first, loadedFirst), _mm256_cmpeq_epi16(last, loadedLast));
+            }
+            else
+            {
+                equal = _mm256_and_si256(_mm256_cmpeq_epi32(first, loadedFirst), _mm256_cmpeq_epi32(last, loadedLast));
+            }
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(equal));
+        }
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        using VectorT = __m128i;
+
+        [[nodiscard]] static VectorT Broadcast(CharT ch) noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                return _mm_set1_epi8(static_cast<char>(ch));
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                return _mm_set1_epi16(static_cast<short>(ch));
+            }
+            else
+            {
+                return _mm_set1_epi32(static_cast<int>(ch));
+            }
+        }
+
+        /// @brief a bit per byte of the vector, the bits of every character are set if both vectors have it at this position
+        [[nodiscard]] static std::uint32_t MatchMask(VectorT first, VectorT last, const CharT* blockFirst, const CharT* blockLast) noexcept
+        {
+            const auto loadedFirst = _mm_loadu_si128(reinterpret_cast<const VectorT*>(blockFirst));
+            const auto loadedLast = _mm_loadu_si128(reinterpret_cast<const VectorT*>(blockLast));
+            VectorT equal;
+            if constexpr (sizeof(CharT) == 1)
+            {
+                equal = _mm_and_si128(_mm_cmpeq_epi8(first, loadedFirst), _mm_cmpeq_epi8(last, loadedLast));
+            }
+            else if constexpr (sizeof(CharT) == 2)
+            {
+                equal = _mm_and_si128(_mm_cmpeq_epi16(first, loadedFirst), _mm_cmpeq_epi16(last, loadedLast));
+            }
+            else
+            {
+                equal = _mm_and_si128(_mm_cmpeq_epi32(first, loadedFirst), _mm_cmpeq_epi32(last, loadedLast));
+            }
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(equal));
+        }
+#endif
+
+        /// @brief checks the positions by whole vectors, 'offset' becomes the first position which wasn't checked
+        /// @return false if the lambda stopped the search
+        template<class Lambda>
+        static bool SearchVectorized([[maybe_unused]] const CharT* haystack, [[maybe_unused]] SizeT size, [[maybe_unused]] const CharT* needle,
+                                     [[maybe_unused]] SizeT needleSize, [[maybe_unused]] SizeT& offset, [[maybe_unused]] Lambda& lambda)
+        {
+#if defined(__AVX2__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            constexpr SizeT step = sizeof(VectorT) / sizeof(CharT);
+            constexpr std::uint32_t characterBits = (1u << sizeof(CharT)) - 1u;
+
+            const auto first = Broadcast(needle[0]);
+            const auto last = Broadcast(needle[needleSize - 1]);
+            // the last vector which is checked reads up to haystack[offset + step - 1 + needleSize - 1]
+            for (const SizeT lastOffset = size - needleSize; offset + step - 1 <= lastOffset; offset += step)
+            {
+                auto mask = MatchMask(first, last, haystack + offset, haystack + offset + needleSize - 1);
+                while (mask != 0)
+                {
+                    const SizeT index = static_cast<SizeT>(std::countr_zero(mask)) / sizeof(CharT);
+                    if (Traits::compare(haystack + offset + index + 1, needle + 1, needleSize - 2) == 0 && !lambda(offset + index))
+                    {
+                        return false;
+                    }
+                    mask &= ~(characterBits << (index * sizeof(CharT)));
+                }
+            }
+#endif
+            return true;
+        }
+    };
+} // namespace Core
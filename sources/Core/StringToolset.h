@@ -0,0 +1,267 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Core/Assert.h"
+#include "Core/CommonEnums.h"
+#include "Utils/CopyableAndMoveableBehaviour.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <cwctype>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <xstring>
+
+namespace Core
+{
+    template<class CharType>
+    struct _StringSettings : public Utils::Abstract
+    {
+        using CharT = CharType;
+        using SizeT = std::size_t;
+        using HashT = std::size_t;
+        using IndexT = std::size_t;
+        constexpr static SizeT invalidSize = ~static_cast<SizeT>(0);
+    };
+
+    /// @brief hashes 8 bytes per step. It gives the same value at compile time and at runtime, so hashes of literals
+    /// can be computed by the compiler and hashes stored on disk stay valid between runs.
+    template<class CharType>
+    struct _StringHasher : public Utils::Abstract
+    {
+        using CharT = CharType;
+        using SizeT = typename _StringSettings<CharT>::SizeT;
+        using HashT = typename _StringSettings<CharT>::HashT;
+
+        [[nodiscard]] constexpr static HashT Hash(const CharT* string, SizeT size) noexcept
+        {
+            std::uint64_t hash = seed ^ (static_cast<std::uint64_t>(size) * multiplier);
+
+            IndexT index = 0;
+            for (; index + blockSize <= size; index += blockSize)
+            {
+                hash = MixBlock(hash, LoadBlock(string + index, blockSize));
+            }
+
+            if (index < size)
+            {
+                hash = MixBlock(hash, LoadBlock(string + index, size - index));
+            }
+
+            return static_cast<HashT>(Finalize(hash));
+        }
+
+    private:
+        using IndexT = typename _StringSettings<CharT>::IndexT;
+        using UnsignedCharT = std::make_unsigned_t<CharT>;
+
+        constexpr static SizeT blockSize = sizeof(std::uint64_t) / sizeof(CharT);
+        constexpr static std::uint64_t seed = 0xCBF29CE484222325ull;
+        constexpr static std::uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+
+        [[nodiscard]] constexpr static std::uint64_t LoadBlock(const CharT* string, SizeT count) noexcept
+        {
+            std::uint64_t block = 0;
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    std::memcpy(&block, string, count * sizeof(CharT));
+                    return block;
+                }
+            }
+
+            for (IndexT i = 0; i < count; ++i)
+            {
+                block |= static_cast<std::uint64_t>(static_cast<UnsignedCharT>(string[i])) << (i * sizeof(CharT) * 8);
+            }
+
+            return block;
+        }
+
+        [[nodiscard]] constexpr static std::uint64_t MixBlock(std::uint64_t hash, std::uint64_t block) noexcept
+        {
+            hash = (hash ^ block) * multiplier;
+            return hash ^ (hash >> 32);
+        }
+
+        [[nodiscard]] constexpr static std::uint64_t Finalize(std::uint64_t hash) noexcept
+        {
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ull;
+            return hash ^ (hash >> 33);
+        }
+    };
+
+    template<class CharType>
+    struct _StringToolset;
+
+    template<>
+    struct _StringToolset<char> : public Utils::Abstract
+    {
+        using CharT = char;
+        using StdStringT = std::basic_string<CharT, std::char_traits<CharT>, std::allocator<CharT>>;
+        using StdStringViewT = std::basic_string_view<CharT, std::char_traits<CharT>>;
+        using StdRegex = std::basic_regex<CharT, std::regex_traits<CharT>>;
+        using SizeT = typename _StringSettings<CharT>::SizeT;
+
+        [[nodiscard]] static bool IsSpace(int ch) { return static_cast<bool>(isspace(ch)); }
+        [[nodiscard]] static SizeT Length(const CharT* string) noexcept { return static_cast<SizeT>(strlen(string)); }
+
+        [[nodiscard]] static int ToInt(const CharT* str) noexcept { return atoi(str); }
+        [[nodiscard]] static float ToFloat(const CharT* str) noexcept { return static_cast<float>(atof(str)); }
+        [[nodiscard]] static double ToDouble(const CharT* str) noexcept { return atof(str); }
+        [[nodiscard]] static long long ToLongLong(const CharT* str) noexcept { return atoll(str); }
+
+        static void FromInt(int value, CharT* buffer, SizeT bufferSize)
+        {
+            if (const auto errorCode = snprintf(buffer, bufferSize, "%d", value); errorCode < 0)
+            {
+                Assert("Impossible to convert 'int' value to string.");
+            }
+        }
+
+        static void FromFloat(float value, CharT* buffer, SizeT bufferSize)
+        {
+            if (const auto errorCode = snprintf(buffer, bufferSize, "%f", value); errorCode < 0)
+            {
+                Assert("Impossible to convert 'float' value to string.");
+            }
+        }
+
+        static void FromDouble(double value, CharT* buffer, SizeT bufferSize)
+        {
+            if (const auto errorCode = snprintf(buffer, bufferSize, "%lf", value); errorCode < 0)
+            {
+                Assert("Impossible to convert 'double' value to string.");
+            }
+        }
+
+        static void FromUnsignedLongLong(unsigned long long value, CharT* buffer, SizeT bufferSize)
+        {
+            if (const auto errorCode = snprintf(buffer, bufferSize, "%llu", value); errorCode < 0)
+            {
+                Assert("Impossible to convert 'long long' value to string.");
+            }
+        }
+
+        [[nodiscard]] static CharT* StrTok(CharT* string, const CharT* delim, CharT*& context) noexcept { return strtok_s(string, delim, &context); };
+        [[nodiscard]] static CharT* StrStr(CharT* mainString, const CharT* subString) noexcept { return strstr(mainString, subString); };
+
+        // the value must be representable as unsigned char, negative characters are undefined behaviour for toupper
+        [[nodiscard]] static int ToUpper(const CharT ch) noexcept { return toupper(static_cast<unsigned char>(ch)); };
+        [[nodiscard]] static int ToLower(const CharT ch) noexcept { return tolower(static_cast<unsigned char>(ch)); };
+
+        [[nodiscard]] static Comparison Cmp(const CharT* str1, const CharT* str2) noexcept
+        {
+            const int result = strcmp(str1, str2);
+            if (result == 0)
+            {
+                return Comparison::Equal;
+            }
+            if (result > 0)
+            {
+                return Comparison::Greater;
+            }
+
+            return Comparison::Less;
+        }
+    };
+
+    template<>
+    struct _StringToolset<wchar_t> : public Utils::Abstract
+    {
+        using CharT = wchar_t;
+        using StdStringT = std::basic_string<CharT, std::char_traits<CharT>, std::allocator<CharT>>;
+        using StdStringViewT = std::basic_string_view<CharT, std::char_traits<CharT>>;
+        using StdRegex = std::basic_regex<CharT, std::regex_traits<CharT>>;
+        using SizeT = typename _StringSettings<CharT>::SizeT;
+
+        [[nodiscard]] static bool IsSpace(wint_t ch) { return static_cast<bool>(std::iswspace(ch)); }
+        [[nodiscard]] static SizeT Length(const CharT* string) noexcept { return static_cast<SizeT>(wcslen(string)); }
+
+        [[nodiscard]] static int ToInt(const CharT* str) noexcept { return _wtoi(str); }
+        [[nodiscard]] static float ToFloat(const CharT* str) noexcept { return static_cast<float>(_wtof(str)); }
+        [[nodiscard]] static double ToDouble(const CharT* str) noexcept { return _wtof(str); }
+        [[nodiscard]] static long long ToLongLong(const CharT* str) noexcept { return _wtoll(str); }
+
+        static void FromInt(int value, CharT* buffer, SizeT bufferSize)
+        {
+            if (const auto errorCode = _snwprintf_s(buffer, bufferSize, bufferSize, L"%d", value); errorCode < 0)
+            {
+                Assert("Impossible to convert 'int' value to string.");
+            }
+        }
+
+        static void FromFloat(float value, CharT* buffer, SizeT bufferSize)
+        {
+            if (const auto errorCode = _snwprintf_s(buffer, bufferSize, bufferSize, L"%f", value); errorCode < 0)
+            {
+                Assert("Impossible to convert 'float' value to string.");
+            }
+        }
+
+        static void FromDouble(double value, CharT* buffer, SizeT bufferSize)
+        {
+            if (const auto errorCode = _snwprintf_s(buffer, bufferSize, bufferSize, L"%lf", value); errorCode < 0)
+            {
+                Assert("Impossible to convert 'double' value to string.");
+            }
+        }
+
+        static void FromUnsignedLongLong(unsigned long long value, CharT* buffer, SizeT bufferSize)
+        {
+            if (const auto errorCode = _snwprintf_s(buffer, bufferSize, bufferSize, L"%llu", value); errorCode < 0)
+            {
+                Assert("Impossible to convert 'long long' value to string.");
+            }
+        }
+
+        [[nodiscard]] static CharT* StrTok(CharT* string, const CharT* delim, CharT*& context) noexcept { return wcstok_s(string, delim, &context); };
+        [[nodiscard]] static CharT* StrStr(CharT* mainString, const CharT* subString) noexcept { return wcsstr(mainString, subString); };
+
+        [[nodiscard]] static std::wint_t ToUpper(const CharT ch) noexcept { return towupper(ch); };
+        [[nodiscard]] static std::wint_t ToLower(const CharT ch) noexcept { return towlower(ch); };
+
+        [[nodiscard]] static Comparison Cmp(const CharT* str1, const CharT* str2) noexcept
+        {
+            const int result = wcscmp(str1, str2);
+            if (result == 0)
+            {
+                return Comparison::Equal;
+            }
+            if (result > 0)
+            {
+                return Comparison::Greater;
+            }
+
+            return Comparison::Less;
+        }
+    };
+} // namespace Core
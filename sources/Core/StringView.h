@@ -0,0 +1,645 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "Core/AbstractIterators.h"
+#include "Core/Assert.h"
+#include "Core/CommonEnums.h"
+#include "Core/String.h"
+#include "Core/StringCase.h"
+#include "Core/StringSearch.h"
+#include "Core/StringToolset.h"
+#include "Utils/CopyableAndMoveableBehaviour.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <functional>
+#include <ranges>
+#include <regex>
+#include <type_traits>
+#include <vector>
+
+namespace Core
+{
+    template<class CharType>
+    class SplitView;
+
+    /// @brief a non-owning slice of characters with the read-only API of BaseString. It never allocates and it isn't
+    /// null-terminated. BaseString converts to it for free, the viewed characters must outlive the view.
+    template<class CharType>
+    class BaseStringView : public Utils::CopyableAndMoveable
+    {
+    public:
+        using CharT = CharType;
+        using Self = BaseStringView<CharT>;
+        using Toolset = _StringToolset<CharT>;
+        using Settings = _StringSettings<CharT>;
+        using SizeT = typename Settings::SizeT;
+        using HashT = typename Settings::HashT;
+        using IndexT = typename Settings::IndexT;
+        using StdStringViewT = typename Toolset::StdStringViewT;
+        using StdRegex = typename Toolset::StdRegex;
+        using StdRegexMatchResults = std::match_results<const CharT*>;
+        using Hasher = _StringHasher<CharT>;
+        using Case = _StringCase<CharT>;
+        using Search = _StringSearch<CharT>;
+        using StringT = BaseString<CharT>;
+
+        using value_type = CharT;
+        using const_iterator = const CharT*;
+        using iterator = const_iterator;
+
+    public:
+        constexpr BaseStringView() noexcept = default;
+
+        constexpr BaseStringView(const CharT* string, SizeT size) noexcept
+            : _string{ string },
+              _size{ size }
+        {
+        }
+
+        constexpr BaseStringView(const CharT* string) noexcept
+            : BaseStringView(StdStringViewT(string))
+        {
+        }
+
+        constexpr BaseStringView(StdStringViewT string) noexcept
+            : _string{ string.data() },
+              _size{ string.size() }
+        {
+        }
+
+        BaseStringView(const StringT& string) noexcept
+            : _string{ string.data() },
+              _size{ string.Size() }
+        {
+        }
+
+        [[nodiscard]] const CharT* begin() const noexcept { return _string; }
+        [[nodiscard]] const CharT* cbegin() const noexcept { return _string; }
+        [[nodiscard]] const CharT* end() const noexcept { return _string + _size; }
+        [[nodiscard]] const CharT* cend() const noexcept { return _string + _size; }
+
+        [[nodiscard]] SizeT Size() const noexcept { return _size; }
+        [[nodiscard]] SizeT Length() const noexcept { return _size; }
+        [[nodiscard]] bool IsEmpty() const noexcept { return _string == nullptr || _size == 0; }
+        [[nodiscard]] bool operator!() const noexcept { return IsEmpty(); }
+        [[nodiscard]] explicit operator bool() const noexcept { return !IsEmpty(); }
+
+        [[nodiscard]] const CharT* data() const noexcept { return _string; }
+        [[nodiscard]] const CharT* Data() const noexcept { return data(); }
+
+        [[nodiscard]] CharT operator[](IndexT index) const noexcept { return _string[index]; }
+
+        [[nodiscard]] CharT At(IndexT index) const noexcept
+        {
+            if (!Verify(index < _size, "Impossible to work with nullptr string. or invalid index."))
+            {
+                return {};
+            }
+
+            return _string[index];
+        }
+
+        [[nodiscard]] CharT Front() const
+        {
+            if (IsEmpty())
+            {
+                Assert("Impossible to work with nullptr string.");
+                return {};
+            }
+
+            return _string[0];
+        }
+
+        [[nodiscard]] CharT Back() const
+        {
+            if (IsEmpty())
+            {
+                Assert("Impossible to work with nullptr string.");
+                return {};
+            }
+
+            return _string[_size - static_cast<SizeT>(1)];
+        }
+
+        [[nodiscard]] StdStringViewT ToStringView() const noexcept { return IsEmpty() ? StdStringViewT() : StdStringViewT(_string, _size); }
+        [[nodiscard]] operator StdStringViewT() const noexcept { return ToStringView(); }
+
+        /// @brief the only way to get an owning copy, it allocates
+        [[nodiscard]] StringT ToString() const { return StringT(ToStringView()); }
+
+        // views, BaseStrings, std::basic_string_views and literals are compared by the characters without conversions
+        template<class T>
+            requires std::is_convertible_v<const T&, StdStringViewT>
+        [[nodiscard]] bool operator==(const T& other) const noexcept
+        {
+            return ToStringView() == StdStringViewT(other);
+        }
+
+        template<class T>
+            requires std::is_convertible_v<const T&, StdStringViewT>
+        [[nodiscard]] bool operator<(const T& other) const noexcept
+        {
+            return ToStringView() < StdStringViewT(other);
+        }
+
+        template<class T>
+            requires std::is_convertible_v<const T&, StdStringViewT>
+        [[nodiscard]] bool operator<=(const T& other) const noexcept
+        {
+            return ToStringView() <= StdStringViewT(other);
+        }
+
+        template<class T>
+            requires std::is_convertible_v<const T&, StdStringViewT>
+        [[nodiscard]] bool operator>(const T& other) const noexcept
+        {
+            return ToStringView() > StdStringViewT(other);
+        }
+
+        template<class T>
+            requires std::is_convertible_v<const T&, StdStringViewT>
+        [[nodiscard]] bool operator>=(const T& other) const noexcept
+        {
+            return ToStringView() >= StdStringViewT(other);
+        }
+
+        [[nodiscard]] Comparison Compare(StdStringViewT other, const bool isIgnoreCase = false) const noexcept
+        {
+            if (!Verify(!IsEmpty() && !other.empty(), "Impossible to work with nullptr string."))
+            {
+                return Comparison::None;
+            }
+
+            const SizeT size = std::min(_size, static_cast<SizeT>(other.size()));
+            const int result =
+                isIgnoreCase ? Case::Compare(_string, other.data(), size) : std::char_traits<CharT>::compare(_string, other.data(), size);
+            if (result != 0)
+            {
+                return result < 0 ? Comparison::Less : Comparison::Greater;
+            }
+
+            if (_size == other.size())
+            {
+                return Comparison::Equal;
+            }
+            return _size < other.size() ? Comparison::Less : Comparison::Greater;
+        }
+
+        [[nodiscard]] bool IsEqualIgnoreCase(StdStringViewT other) const noexcept
+        {
+            return _size == other.size() && Case::IsEqual(_string, other.data(), _size);
+        }
+
+        [[nodiscard]] bool StartsWith(StdStringViewT other) const noexcept { return ToStringView().starts_with(other); }
+        [[nodiscard]] bool EndsWith(StdStringViewT other) const noexcept { return ToStringView().ends_with(other); }
+
+        [[nodiscard]] const CharT* Find(StdStringViewT other, int baseOffset = 0) const noexcept
+        {
+            if (!Verify(!IsEmpty() && !other.empty(), "Impossible to work with nullptr string.") || static_cast<SizeT>(baseOffset) > _size)
+            {
+                return nullptr;
+            }
+
+            const auto offset = Search::Find(_string + baseOffset, _size - baseOffset, other.data(), other.size());
+            return offset == Search::notFound ? nullptr : _string + baseOffset + offset;
+        }
+
+        [[nodiscard]] std::vector<const CharT*> FindAll(StdStringViewT other) const
+        {
+            std::vector<const CharT*> strings;
+            IterateFind(other, [this, &strings](SizeT offset) {
+                strings.push_back(_string + offset);
+                return true;
+            });
+            return strings;
+        }
+
+        [[nodiscard]] std::vector<SizeT> FindAllOffsets(StdStringViewT other) const
+        {
+            std::vector<SizeT> offsets;
+            IterateFind(other, [&offsets](SizeT offset) {
+                offsets.push_back(offset);
+                return true;
+            });
+            return offsets;
+        }
+
+        /// @brief calls the lambda with the offset of every occurrence in increasing order until it returns false
+        template<class Lambda>
+        void IterateFind(StdStringViewT other, Lambda&& lambda) const
+        {
+            if (!Verify(!IsEmpty() && !other.empty(), "Impossible to work with nullptr string."))
+            {
+                return;
+            }
+
+            Search::Search(_string, _size, other.data(), other.size(), lambda);
+        }
+
+        /// @brief the same as BaseString::SubStr: the characters from 'index' to 'count' (exclusive), 0 means the end
+        Self& SubStr(IndexT index, SizeT count = 0) noexcept
+        {
+            if (!IsEmpty())
+            {
+                const SizeT finalCount = count == 0 ? _size - index : count - index;
+                _string += index;
+                _size = finalCount;
+            }
+
+            return *this;
+        }
+
+        Self& TrimStart(CharT ch) noexcept
+        {
+            while (_size != 0 && _string[0] == ch)
+            {
+                ++_string;
+                --_size;
+            }
+
+            return *this;
+        }
+
+        Self& TrimEnd(CharT ch) noexcept
+        {
+            while (_size != 0 && _string[_size - static_cast<SizeT>(1)] == ch)
+            {
+                --_size;
+            }
+
+            return *this;
+        }
+
+        Self& Trim(CharT ch) noexcept { return TrimStart(ch).TrimEnd(ch); }
+
+        /// @brief the same tokens as BaseString::Split: every character of 'delimiter' separates them and empty tokens
+        /// are skipped. The tokens point into the viewed string.
+        [[nodiscard]] std::vector<Self> Split(StdStringViewT delimiter) const
+        {
+            if (!Verify(!IsEmpty(), "Impossible to work with nullptr string."))
+            {
+                return {};
+            }
+
+            std::vector<Self> splittedStrings;
+            for (const auto field : SplitView<CharT>(*this, delimiter))
+            {
+                splittedStrings.push_back(field);
+            }
+
+            return splittedStrings;
+        }
+
+        [[nodiscard]] bool RegexMatch(StdStringViewT expr, std::regex_constants::match_flag_type flag = std::regex_constants::match_default) const
+        {
+            if (!IsEmpty())
+            {
+                return std::regex_match(begin(), end(), StdRegex(expr.data(), expr.size()), flag);
+            }
+
+            return false;
+        }
+
+        [[nodiscard]] bool RegexMatch(StdStringViewT expr, StdRegexMatchResults& match,
+                                      std::regex_constants::match_flag_type flag = std::regex_constants::match_default) const
+        {
+            if (!IsEmpty())
+            {
+                return std::regex_match(begin(), end(), match, StdRegex(expr.data(), expr.size()), flag);
+            }
+
+            return false;
+        }
+
+        [[nodiscard]] StdRegexMatchResults FindRegex(StdStringViewT expr, int baseOffset = 0,
+                                                     std::regex_constants::match_flag_type flag = std::regex_constants::match_default) const
+        {
+            if (!Verify(!IsEmpty() && !expr.empty(), "Impossible to work with nullptr string."))
+            {
+                return {};
+            }
+
+            StdRegexMatchResults match;
+            std::regex_search(begin() + baseOffset, end(), match, StdRegex(expr.data(), expr.size()), flag);
+
+            return match;
+        }
+
+        void IterateRegex(StdStringViewT expr, std::function<bool(const StdRegexMatchResults&)>&& lambda, int baseOffset = 0,
+                          std::regex_constants::match_flag_type flag = std::regex_constants::match_default) const
+        {
+            if (!Verify(!IsEmpty() && !expr.empty(), "Impossible to work with nullptr string."))
+            {
+                return;
+            }
+
+            StdRegex regexExpr(expr.data(), expr.size());
+            auto first = std::regex_iterator<const CharT*>(begin() + baseOffset, end(), regexExpr, flag);
+            auto last = std::regex_iterator<const CharT*>();
+            for (; first != last; ++first)
+            {
+                if (lambda)
+                {
+                    if (!std::invoke(lambda, *first))
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        /// @brief parses the number the same way as BaseString::ConvertTo. The view isn't null-terminated, so the
+        /// characters are copied to a buffer on the stack, a number can't be longer than 'maxNumberSize'.
+        template<class T>
+        [[nodiscard]] T ConvertTo() const noexcept
+        {
+            static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, long long>,
+                          "Unsupported type");
+
+            if (IsEmpty())
+            {
+                Assert("Impossible to work with nullptr string.");
+                return {};
+            }
+
+            CharT buffer[maxNumberSize + 1]{};
+            std::copy_n(_string, std::min(_size, maxNumberSize), buffer);
+            if constexpr (std::is_same_v<T, int>)
+            {
+                return Toolset::ToInt(buffer);
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                return Toolset::ToFloat(buffer);
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                return Toolset::ToDouble(buffer);
+            }
+            else
+            {
+                return Toolset::ToLongLong(buffer);
+            }
+        }
+
+        /// @brief equal to the hash of a BaseString with the same characters
+        [[nodiscard]] HashT MakeHash() const noexcept
+        {
+            if (IsEmpty())
+            {
+                Assert("Impossible to make a hash from nullptr string.");
+                return {};
+            }
+
+            return Hasher::Hash(_string, _size);
+        }
+
+    private:
+        constexpr static SizeT maxNumberSize = 63;
+
+        const CharT* _string = nullptr;
+        SizeT _size = 0;
+    };
+
+    using StringAtomView = BaseStringView<char>;
+    using WStringAtomView = BaseStringView<wchar_t>;
+
+    static_assert(std::is_trivially_copyable_v<StringAtomView> && std::is_trivially_copyable_v<WStringAtomView>);
+
+    enum class SplitDelimiter
+    {
+        // every character of the delimiter separates the fields, the same as BaseString::Split
+        AnyOf,
+        // only the whole delimiter separates the fields
+        Exact
+    };
+
+    /// @brief a lazy split: the fields are found one at a time while the range is iterated, they are views of the string
+    /// and nothing is allocated. The string and the delimiter must outlive the range. An empty string has no fields.
+    template<class CharType>
+    class SplitView : public Utils::CopyableAndMoveable
+    {
+    public:
+        using CharT = CharType;
+        using StringViewT = BaseStringView<CharT>;
+        using StdStringViewT = typename StringViewT::StdStringViewT;
+
+        class Iterator : public IForwardIterator<StringViewT, Iterator, Utils::CopyableAndMoveable>
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = StringViewT;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const StringViewT*;
+            using reference = const StringViewT&;
+
+        public:
+            Iterator() = default;
+
+            [[nodiscard]] bool operator==(const Iterator& other) const noexcept
+            {
+                return _isEnd == other._isEnd && (_isEnd || (_field.data() == other._field.data() && _next == other._next));
+            }
+
+            [[nodiscard]] const StringViewT& operator*() const noexcept { return _field; }
+            [[nodiscard]] const StringViewT* operator->() const noexcept { return &_field; }
+
+            Iterator& operator++() noexcept
+            {
+                Advance();
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                auto temp = *this;
+                Advance();
+                return temp;
+            }
+
+            void Swap(Iterator& other) noexcept { std::swap(*this, other); }
+
+        private:
+            explicit Iterator(const SplitView* owner) noexcept
+                : _owner{ owner },
+                  _next{ owner->_string.IsEmpty() ? nullptr : owner->_string.data() },
+                  _isEnd{ false }
+            {
+                Advance();
+            }
+
+            void Advance() noexcept
+            {
+                const CharT* last = _owner->_string.end();
+                if (_next && !_owner->_isKeepEmpty)
+                {
+                    _next = _owner->SkipDelimiters(_next, last);
+                    if (_next == last)
+                    {
+                        _next = nullptr;
+                    }
+                }
+
+                if (!_next)
+                {
+                    _field = {};
+                    _isEnd = true;
+                    return;
+                }
+
+                const CharT* delimiter = _owner->FindDelimiter(_next, last);
+                _field = StringViewT(_next, static_cast<typename StringViewT::SizeT>(delimiter - _next));
+                _next = delimiter == last ? nullptr : delimiter + _owner->GetDelimiterSize();
+            }
+
+        private:
+            const SplitView* _owner = nullptr;
+            // the beginning of the next field, nullptr after the last one
+            const CharT* _next = nullptr;
+            StringViewT _field;
+            bool _isEnd = true;
+
+            friend class SplitView;
+        };
+
+    public:
+        SplitView(StringViewT string, StdStringViewT delimiter, SplitDelimiter type = SplitDelimiter::AnyOf, bool isKeepEmpty = false) noexcept
+            : _string{ string },
+              _delimiter{ delimiter },
+              _type{ type },
+              _isKeepEmpty{ isKeepEmpty }
+        {
+            Verify(!delimiter.empty(), "The delimiter is empty, the string is a single field.");
+            if constexpr (sizeof(CharT) == 1)
+            {
+                for (const auto ch : delimiter)
+                {
+                    const auto index = static_cast<unsigned char>(ch);
+                    _delimiterSet[index / 64] |= std::uint64_t{ 1 } << (index % 64);
+                }
+            }
+        }
+
+        [[nodiscard]] Iterator begin() const noexcept { return Iterator(this); }
+        [[nodiscard]] Iterator end() const noexcept { return {}; }
+
+    private:
+        /// @brief the first delimiter in [first, last) or 'last'
+        [[nodiscard]] const CharT* FindDelimiter(const CharT* first, const CharT* last) const noexcept
+        {
+            if (_delimiter.empty())
+            {
+                return last;
+            }
+
+            if (_type == SplitDelimiter::Exact)
+            {
+                const auto offset = _StringSearch<CharT>::Find(first, last - first, _delimiter.data(), _delimiter.size());
+                return offset == _StringSearch<CharT>::notFound ? last : first + offset;
+            }
+
+            if (_delimiter.size() == 1)
+            {
+                // memchr-like search for the most common case: lines, csv fields
+                const CharT* found = std::char_traits<CharT>::find(first, last - first, _delimiter[0]);
+                return found ? found : last;
+            }
+
+            while (first != last && !IsDelimiter(*first))
+            {
+                ++first;
+            }
+            return first;
+        }
+
+        /// @brief the first character in [first, last) which doesn't start a delimiter or 'last'
+        [[nodiscard]] const CharT* SkipDelimiters(const CharT* first, const CharT* last) const noexcept
+        {
+            if (_delimiter.empty())
+            {
+                return first;
+            }
+
+            if (_type == SplitDelimiter::Exact)
+            {
+                while (StdStringViewT(first, last - first).starts_with(_delimiter))
+                {
+                    first += _delimiter.size();
+                }
+                return first;
+            }
+
+            while (first != last && IsDelimiter(*first))
+            {
+                ++first;
+            }
+            return first;
+        }
+
+        /// @brief a character of the AnyOf delimiter, narrow characters are looked up in a table
+        [[nodiscard]] bool IsDelimiter(CharT ch) const noexcept
+        {
+            if constexpr (sizeof(CharT) == 1)
+            {
+                const auto index = static_cast<unsigned char>(ch);
+                return (_delimiterSet[index / 64] >> (index % 64)) & 1;
+            }
+            else
+            {
+                return BaseString<CharT>::IsContainChar(ch, _delimiter);
+            }
+        }
+
+        [[nodiscard]] std::size_t GetDelimiterSize() const noexcept { return _type == SplitDelimiter::Exact ? _delimiter.size() : 1; }
+
+    private:
+        StringViewT _string;
+        StdStringViewT _delimiter;
+        SplitDelimiter _type = SplitDelimiter::AnyOf;
+        bool _isKeepEmpty = false;
+        std::array<std::uint64_t, 4> _delimiterSet{};
+    };
+
+    template<class CharType, class... Args>
+    SplitView(const BaseString<CharType>&, Args&&...) -> SplitView<CharType>;
+
+    template<class CharType, class... Args>
+    SplitView(BaseStringView<CharType>, Args&&...) -> SplitView<CharType>;
+
+    using StringSplitView = SplitView<char>;
+    using WStringSplitView = SplitView<wchar_t>;
+
+    static_assert(IsForwardIterator<StringSplitView::Iterator> && std::forward_iterator<StringSplitView::Iterator>);
+    static_assert(std::ranges::forward_range<StringSplitView>);
+} // namespace Core
+
+template<class CharType>
+struct std::hash<Core::BaseStringView<CharType>>
+{
+    size_t operator()(const Core::BaseStringView<CharType>& x) const noexcept { return x.MakeHash(); }
+};
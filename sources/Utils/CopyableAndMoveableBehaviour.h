@@ -24,65 +24,78 @@
 
 namespace Utils
 {
+    /// @brief a base of the copy/move policies. The policies have no virtual members, so they don't add a vptr and
+    /// keep trivial types trivially copyable. The destructors are protected because a policy is never deleted by itself.
     class CopyableAndMoveableBehaviour
     {
-    public:
-        virtual ~CopyableAndMoveableBehaviour() = default;
+    protected:
+        CopyableAndMoveableBehaviour() = default;
+        ~CopyableAndMoveableBehaviour() = default;
     };
 
     class CopyableAndMoveable : public CopyableAndMoveableBehaviour
     {
     public:
         CopyableAndMoveable() = default;
-        ~CopyableAndMoveable() override = default;
         CopyableAndMoveable(CopyableAndMoveable&&) = default;
         CopyableAndMoveable& operator=(CopyableAndMoveable&&) = default;
         CopyableAndMoveable(const CopyableAndMoveable&) = default;
         CopyableAndMoveable& operator=(const CopyableAndMoveable&) = default;
+
+    protected:
+        ~CopyableAndMoveable() = default;
     };
 
     class CopyableButNotMoveable : public CopyableAndMoveableBehaviour
     {
     public:
         CopyableButNotMoveable() = default;
-        ~CopyableButNotMoveable() override = default;
         CopyableButNotMoveable(CopyableButNotMoveable&&) = delete;
         CopyableButNotMoveable& operator=(CopyableButNotMoveable&&) = delete;
         CopyableButNotMoveable(const CopyableButNotMoveable&) = default;
         CopyableButNotMoveable& operator=(const CopyableButNotMoveable&) = default;
+
+    protected:
+        ~CopyableButNotMoveable() = default;
     };
 
     class NotCopyableAndNotMoveable : public CopyableAndMoveableBehaviour
     {
     public:
         NotCopyableAndNotMoveable() = default;
-        ~NotCopyableAndNotMoveable() override = default;
         NotCopyableAndNotMoveable(NotCopyableAndNotMoveable&&) = delete;
         NotCopyableAndNotMoveable& operator=(NotCopyableAndNotMoveable&&) = delete;
         NotCopyableAndNotMoveable(const NotCopyableAndNotMoveable&) = delete;
         NotCopyableAndNotMoveable& operator=(const NotCopyableAndNotMoveable&) = delete;
+
+    protected:
+        ~NotCopyableAndNotMoveable() = default;
     };
 
     class NotCopyableButMoveable : public CopyableAndMoveableBehaviour
     {
     public:
         NotCopyableButMoveable() = default;
-        ~NotCopyableButMoveable() override = default;
         NotCopyableButMoveable(NotCopyableButMoveable&&) = default;
         NotCopyableButMoveable& operator=(NotCopyableButMoveable&&) = default;
         NotCopyableButMoveable(const NotCopyableButMoveable&) = delete;
         NotCopyableButMoveable& operator=(const NotCopyableButMoveable&) = delete;
+
+    protected:
+        ~NotCopyableButMoveable() = default;
     };
 
     class Abstract : public CopyableAndMoveableBehaviour
     {
     public:
         Abstract() = delete;
-        ~Abstract() override = default;
         Abstract(Abstract&&) = delete;
         Abstract& operator=(Abstract&&) = delete;
         Abstract(const Abstract&) = delete;
         Abstract& operator=(const Abstract&) = delete;
+
+    protected:
+        ~Abstract() = default;
     };
 
 } // namespace Utils
\ No newline at end of file
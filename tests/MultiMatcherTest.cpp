@@ -0,0 +1,190 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Core/MultiMatcher.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    using Match = Core::StringMultiMatcher::Match;
+
+    // every occurrence of every keyword sorted like the matcher reports them: by the end, a longer keyword first
+    std::vector<Match> FindAllByLoop(const std::vector<std::string>& patterns, std::string_view text)
+    {
+        std::vector<Match> matches;
+        for (std::size_t id = 0; id < patterns.size(); ++id)
+        {
+            for (auto offset = text.find(patterns[id]); offset != std::string_view::npos; offset = text.find(patterns[id], offset + 1))
+            {
+                matches.push_back({ id, offset, patterns[id].size() });
+            }
+        }
+
+        std::ranges::sort(matches, [](const Match& left, const Match& right) {
+            return std::tuple(left.offset + left.size, right.size, left.patternId) <
+                   std::tuple(right.offset + right.size, left.size, right.patternId);
+        });
+        return matches;
+    }
+} // namespace
+
+TEST(MultiMatcherTest, StringMultiMatcher_FindAll)
+{
+    using Core::StringMultiMatcher;
+
+    {
+        const StringMultiMatcher matcher = { "he", "she", "his", "hers" };
+        EXPECT_EQ(4, matcher.PatternsCount());
+
+        const auto matches = matcher.FindAll("ushers");
+        const std::vector<Match> expected = { { 1, 1, 3 }, { 0, 2, 2 }, { 3, 2, 4 } };
+        EXPECT_EQ(expected, matches);
+    }
+
+    {
+        const StringMultiMatcher matcher = { "error", "warn", "error" };
+
+        const auto matches = matcher.FindAll("[warn] error: no errors");
+        const std::vector<Match> expected = { { 1, 1, 4 }, { 0, 7, 5 }, { 2, 7, 5 }, { 0, 17, 5 }, { 2, 17, 5 } };
+        EXPECT_EQ(expected, matches);
+
+        EXPECT_TRUE(matcher.IsContainAny("warning"_atom));
+        EXPECT_FALSE(matcher.IsContainAny("info: ok"));
+        EXPECT_FALSE(matcher.IsContainAny(""));
+        EXPECT_EQ((Match{ 1, 1, 4 }), matcher.FindFirst("[warn] error"));
+    }
+
+    {
+        const StringMultiMatcher matcher;
+        EXPECT_TRUE(matcher.FindAll("text").empty());
+    }
+
+    {
+        const std::vector<std::string> patterns = { "a", "aa", "aaa" };
+        const StringMultiMatcher matcher(patterns);
+
+        int count = 0;
+        matcher.Iterate("aaaa", [&count](const Match&) { return ++count != 3; });
+        EXPECT_EQ(3, count);
+        EXPECT_EQ(FindAllByLoop(patterns, "aaaa"), matcher.FindAll("aaaa"));
+    }
+}
+
+TEST(MultiMatcherTest, StringMultiMatcher_Random)
+{
+    using Core::StringMultiMatcher;
+
+    std::mt19937 random(42);
+    const auto makeString = [&random](std::size_t size) {
+        // a small alphabet with zero makes many overlapping matches
+        std::string result(size, '\0');
+        for (auto& ch : result)
+        {
+            ch = "ab\0c\xff"[random() % 5];
+        }
+        return result;
+    };
+
+    for (int i = 0; i < 50; ++i)
+    {
+        std::vector<std::string> patterns;
+        for (std::size_t j = 0, count = 1 + random() % 20; j < count; ++j)
+        {
+            patterns.push_back(makeString(1 + random() % 6));
+        }
+
+        const StringMultiMatcher matcher(patterns);
+        const auto text = makeString(random() % 500);
+        ASSERT_EQ(FindAllByLoop(patterns, text), matcher.FindAll(text));
+    }
+}
+
+TEST(MultiMatcherTest, StringMultiMatcher_Stream)
+{
+    using Core::StringMultiMatcher;
+
+    const std::vector<std::string> patterns = { "GET /", "POST /", "HTTP/1.1", "/api/" };
+    const StringMultiMatcher matcher(patterns);
+    const std::string text = "GET /api/v1 HTTP/1.1\nPOST /api/v2 HTTP/1.1\n";
+    const auto expected = FindAllByLoop(patterns, text);
+
+    for (std::size_t chunkSize = 1; chunkSize <= text.size(); ++chunkSize)
+    {
+        std::vector<Match> matches;
+        auto stream = matcher.MakeStream();
+        for (std::size_t offset = 0; offset < text.size(); offset += chunkSize)
+        {
+            stream.Feed(std::string_view(text).substr(offset, chunkSize), [&matches](const Match& match) {
+                matches.push_back(match);
+                return true;
+            });
+        }
+
+        EXPECT_EQ(text.size(), stream.Offset());
+        ASSERT_EQ(expected, matches) << "chunk size " << chunkSize;
+    }
+
+    auto stream = matcher.MakeStream();
+    stream.Feed("GET /ap", [](const Match&) { return true; });
+    stream.Reset();
+
+    std::vector<Match> matches;
+    stream.Feed("i/", [&matches](const Match& match) {
+        matches.push_back(match);
+        return true;
+    });
+    EXPECT_TRUE(matches.empty());
+
+    {
+        // the stop doesn't break the state: "abXYZc" has no "abc"
+        const StringMultiMatcher shortMatcher = { "ab", "abc", "Zc" };
+        auto shortStream = shortMatcher.MakeStream();
+        std::vector<Match> found;
+        const auto collectFirst = [&found](const Match& match) {
+            found.push_back(match);
+            return false;
+        };
+
+        shortStream.Feed("abXYZ", collectFirst);
+        shortStream.Feed("c", collectFirst);
+        const std::vector<Match> expected = { { 0, 0, 2 }, { 2, 4, 2 } };
+        EXPECT_EQ(expected, found);
+        EXPECT_EQ(6, shortStream.Offset());
+    }
+}
+
+TEST(MultiMatcherTest, WStringMultiMatcher_FindAll)
+{
+    using Core::WStringMultiMatcher;
+
+    const WStringMultiMatcher matcher = { L"привіт", L"віт", L"hello" };
+    const auto matches = matcher.FindAll(L"hello, привіт!"_atom);
+    const std::vector<WStringMultiMatcher::Match> expected = { { 2, 0, 5 }, { 0, 7, 6 }, { 1, 10, 3 } };
+    EXPECT_EQ(expected, matches);
+    EXPECT_FALSE(matcher.IsContainAny(L"ві hell"));
+}
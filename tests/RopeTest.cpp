@@ -0,0 +1,216 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Core/Rope.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+TEST(RopeTest, StringRope_Creation)
+{
+    using Core::StringAtom;
+    using Core::StringRope;
+
+    {
+        const StringRope rope;
+
+        EXPECT_TRUE(rope.IsEmpty());
+        EXPECT_EQ(0, rope.Size());
+        EXPECT_TRUE(rope.ToString().IsEmpty());
+    }
+
+    {
+        const StringRope rope("Hello World!");
+
+        EXPECT_EQ(12, rope.Size());
+        EXPECT_TRUE(rope == "Hello World!");
+        EXPECT_EQ('W', rope[6]);
+    }
+
+    {
+        const StringRope rope("Hello World!"_atom);
+
+        EXPECT_TRUE(rope.ToString().IsStatic());
+        EXPECT_EQ("Hello World!"_atom, rope.ToString());
+    }
+
+    {
+        const StringRope rope(std::string_view("Hello"));
+
+        EXPECT_FALSE(rope == "Hello World!");
+        EXPECT_FALSE(rope == "Hallo");
+        EXPECT_TRUE(rope == "Hello");
+    }
+}
+
+TEST(RopeTest, StringRope_Edit)
+{
+    using Core::StringRope;
+
+    StringRope rope("Hello World!");
+    const StringRope copy = rope;
+
+    rope.Insert(5, ",");
+    EXPECT_TRUE(rope == "Hello, World!");
+
+    rope.Insert(0, ">> ");
+    rope += " <<";
+    EXPECT_TRUE(rope == ">> Hello, World! <<");
+
+    rope.Erase(0, 3);
+    rope.Erase(rope.Size() - 3, 100);
+    EXPECT_TRUE(rope == "Hello, World!");
+
+    EXPECT_TRUE(rope.SubRope(7, 5) == "World");
+    EXPECT_TRUE(rope.SubRope(7, 100) == "World!");
+    EXPECT_TRUE(rope.SubRope(13, 5).IsEmpty());
+
+    EXPECT_TRUE((rope.SubRope(0, 5) + StringRope(" there")) == "Hello there");
+
+    // the copy shares the old tree and never sees the edits
+    EXPECT_TRUE(copy == "Hello World!");
+}
+
+TEST(RopeTest, StringRope_RandomEdits)
+{
+    using Core::StringRope;
+
+    std::mt19937 random(42);
+    std::string model;
+    StringRope rope;
+
+    auto randomIndex = [&random](std::size_t max) { return std::uniform_int_distribution<std::size_t>(0, max)(random); };
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        const std::size_t index = randomIndex(model.size());
+        switch (randomIndex(3))
+        {
+            case 0:
+            case 1:
+            {
+                const std::string piece(randomIndex(400) + 1, static_cast<char>('a' + i % 26));
+                model.insert(index, piece);
+                rope.Insert(index, piece);
+                break;
+            }
+            case 2:
+            {
+                const std::size_t count = randomIndex(300);
+                model.erase(index, count);
+                rope.Erase(index, count);
+                break;
+            }
+            default:
+            {
+                const std::size_t count = randomIndex(500);
+                ASSERT_TRUE(rope.SubRope(index, count) == std::string_view(model).substr(index, count));
+                break;
+            }
+        }
+
+        ASSERT_EQ(model.size(), rope.Size());
+        if (!model.empty())
+        {
+            const std::size_t at = randomIndex(model.size() - 1);
+            ASSERT_EQ(model[at], rope[at]);
+        }
+    }
+
+    EXPECT_TRUE(rope == model);
+    EXPECT_EQ(model, rope.ToString().ToStringView());
+}
+
+TEST(RopeTest, StringRope_Balance)
+{
+    using Core::StringRope;
+
+    const std::string chunk(StringRope::mergeSize + 1, 'x');
+    StringRope rope;
+    for (int i = 0; i < 10000; ++i)
+    {
+        rope += chunk;
+    }
+
+    // an AVL tree of n leaves is never taller than 1.44 * log2(n + 2)
+    EXPECT_EQ(chunk.size() * 10000, rope.Size());
+    EXPECT_LE(rope.Height(), 20);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        rope.Insert(rope.Size() / 2, "y");
+    }
+    EXPECT_LE(rope.Height(), 21);
+}
+
+TEST(RopeTest, StringRope_IterateChunks)
+{
+    using Core::StringRope;
+
+    StringRope rope;
+    for (int i = 0; i < 10; ++i)
+    {
+        rope += std::string(StringRope::mergeSize + 1, static_cast<char>('0' + i));
+    }
+
+    std::string joined;
+    int chunksCount = 0;
+    rope.IterateChunks([&](std::string_view chunk) {
+        joined += chunk;
+        ++chunksCount;
+        return true;
+    });
+    EXPECT_EQ(10, chunksCount);
+    EXPECT_EQ(rope.ToString().ToStringView(), joined);
+
+    chunksCount = 0;
+    rope.IterateChunks([&](std::string_view) { return ++chunksCount < 3; });
+    EXPECT_EQ(3, chunksCount);
+
+    // small neighbours are merged into a single chunk
+    StringRope small("Hello");
+    small += " ";
+    small += "World!";
+    chunksCount = 0;
+    small.IterateChunks([&](std::string_view) {
+        ++chunksCount;
+        return true;
+    });
+    EXPECT_EQ(1, chunksCount);
+}
+
+TEST(RopeTest, WStringRope_Edit)
+{
+    using Core::WStringRope;
+
+    WStringRope rope(L"Hello World!");
+    rope.Insert(5, L",");
+    rope.Insert(0, WStringRope(L">> "));
+
+    EXPECT_TRUE(rope == L">> Hello, World!");
+    EXPECT_EQ(L'W', rope[10]);
+    EXPECT_TRUE(rope.SubRope(3, 5) == L"Hello");
+
+    rope.Erase(0, 3);
+    EXPECT_EQ(L"Hello, World!", rope.ToString());
+}
@@ -0,0 +1,523 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "Core/String.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // a pool which takes any hash, so the collisions can be made on purpose
+    class CollidingPool : public Core::_StringPool<char>
+    {
+    public:
+        using _StringPool::AddWithHash;
+    };
+} // namespace
+
+TEST(StringPoolTest, ConcurrentIntern)
+{
+    using Core::StringAtom;
+
+    constexpr int threadsCount = 8;
+    constexpr int keysCount = 2048;
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < keysCount; ++i)
+    {
+        keys.push_back("StringPoolTest.ConcurrentIntern." + std::to_string(i));
+    }
+
+    std::vector<std::vector<const char*>> results(threadsCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsCount; ++t)
+    {
+        threads.emplace_back([&keys, &result = results[t]]() {
+            for (const auto& key : keys)
+            {
+                result.push_back(StringAtom::Intern(key).c_str());
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int i = 0; i < keysCount; ++i)
+    {
+        EXPECT_EQ(keys[i], results[0][i]);
+        for (int t = 1; t < threadsCount; ++t)
+        {
+            EXPECT_EQ(results[0][i], results[t][i]);
+        }
+    }
+}
+
+TEST(StringPoolTest, LocalPool)
+{
+    Core::_StringPool<char> pool;
+
+    const auto first = pool.Add("Hello", 5);
+    const auto second = pool.Add("Hello", 5);
+    const auto third = pool.Add("World", 5);
+
+    EXPECT_EQ(first.str, second.str);
+    EXPECT_NE(first.str, third.str);
+    EXPECT_STREQ("Hello", first.str);
+    EXPECT_STREQ("World", third.str);
+}
+
+TEST(StringPoolTest, ArenaStorage)
+{
+    Core::_StringPool<char> pool;
+
+    const auto first = pool.Add("Hello", 5);
+    const auto second = pool.Add("World", 5);
+    const std::string big(Core::_StringArena<char>::maxChunkSize * 2, 'x');
+    const auto third = pool.Add(big.data(), big.size());
+    EXPECT_EQ(big, third.str);
+
+    const auto statistics = pool.GetStatistics();
+    EXPECT_EQ(3, statistics.atomsCount);
+    EXPECT_EQ(6 + 6 + big.size() + 1, statistics.charsCount);
+    EXPECT_LE(2, statistics.chunksCount);
+    EXPECT_STREQ("Hello", first.str);
+    EXPECT_STREQ("World", second.str);
+}
+
+TEST(StringPoolTest, HashCollisions)
+{
+    CollidingPool pool;
+
+    constexpr std::size_t hash = 42;
+    const auto first = pool.AddWithHash("Hello", 5, hash);
+    const auto second = pool.AddWithHash("World", 5, hash);
+    const auto third = pool.AddWithHash("Hello!", 6, hash);
+
+    EXPECT_NE(first.str, second.str);
+    EXPECT_NE(first.str, third.str);
+    EXPECT_STREQ("Hello", first.str);
+    EXPECT_STREQ("World", second.str);
+    EXPECT_STREQ("Hello!", third.str);
+
+    EXPECT_EQ(first.str, pool.AddWithHash("Hello", 5, hash).str);
+    EXPECT_EQ(second.str, pool.AddWithHash("World", 5, hash).str);
+    EXPECT_EQ(3, pool.GetStatistics().maxProbeLength);
+}
+
+TEST(StringPoolTest, ManyStrings)
+{
+    Core::_StringPool<char> pool;
+
+    constexpr int keysCount = 100000;
+    std::vector<const char*> pointers;
+    for (int i = 0; i < keysCount; ++i)
+    {
+        const auto key = std::to_string(i);
+        pointers.push_back(pool.Add(key.data(), key.size()).str);
+    }
+
+    for (int i = 0; i < keysCount; ++i)
+    {
+        const auto key = std::to_string(i);
+        EXPECT_EQ(pointers[i], pool.Add(key.data(), key.size()).str);
+        EXPECT_EQ(key, pointers[i]);
+    }
+
+    const auto statistics = pool.GetStatistics();
+    EXPECT_EQ(keysCount, statistics.atomsCount);
+    EXPECT_LE(1.0, statistics.averageProbeLength);
+}
+
+TEST(StringPoolTest, AtomId)
+{
+    using Core::AtomId;
+    using Core::StringAtom;
+
+    static_assert(sizeof(AtomId) == 4);
+
+    const auto str1 = StringAtom::Intern("StringPoolTest.AtomId.First");
+    const auto str2 = StringAtom::Intern("StringPoolTest.AtomId.Second");
+    const auto id1 = str1.GetAtomId();
+    const auto id2 = str2.GetAtomId();
+
+    EXPECT_TRUE(id1.IsValid());
+    EXPECT_TRUE(id2.IsValid());
+    EXPECT_NE(id1, id2);
+    EXPECT_EQ(id1, StringAtom::Intern(std::string("StringPoolTest.AtomId.First")).GetAtomId());
+    EXPECT_EQ(str1.c_str(), StringAtom::FromAtomId(id1).c_str());
+    EXPECT_EQ("StringPoolTest.AtomId.Second", Core::_StringPool<char>::Instance().GetView(id2));
+
+    EXPECT_FALSE(StringAtom("dynamic").GetAtomId().IsValid());
+    EXPECT_FALSE(AtomId{}.IsValid());
+
+    std::unordered_map<AtomId, int> map;
+    map[id1] = 1;
+    map[id2] = 2;
+    EXPECT_EQ(1, map[str1.GetAtomId()]);
+}
+
+TEST(StringPoolTest, AtomIdDense)
+{
+    Core::_StringPool<char> pool;
+
+    constexpr int keysCount = 5000;
+    for (int i = 0; i < keysCount; ++i)
+    {
+        const auto key = std::to_string(i);
+        const auto data = pool.Add(key.data(), key.size());
+        EXPECT_EQ(i, data.entry->id.value);
+        EXPECT_EQ(key, pool.GetView(data.entry->id));
+    }
+
+    EXPECT_EQ(nullptr, pool.Resolve(Core::AtomId{ keysCount }).str);
+}
+
+TEST(StringPoolTest, Snapshot)
+{
+    const auto path = std::filesystem::temp_directory_path() / "StringPoolTest.Snapshot.bin";
+
+    constexpr int keysCount = 3000;
+    std::vector<std::string> keys;
+    {
+        Core::_StringPool<char> pool;
+        for (int i = 0; i < keysCount; ++i)
+        {
+            keys.push_back("StringPoolTest.Snapshot." + std::to_string(i));
+            (void)pool.Add(keys.back().data(), keys.back().size());
+        }
+        ASSERT_TRUE(pool.SaveSnapshot(path));
+    }
+
+    Core::_StringPool<char> pool;
+    const auto existing = pool.Add("StringPoolTest.Snapshot.7", 25);
+    ASSERT_TRUE(pool.LoadSnapshot(path));
+    std::filesystem::remove(path);
+
+    const auto statistics = pool.GetStatistics();
+    EXPECT_EQ(keysCount, statistics.atomsCount);
+    EXPECT_LT(0, statistics.mappedBytes);
+    // only the string interned before the loading was copied into the arena
+    EXPECT_EQ(26, statistics.charsCount);
+
+    for (int i = 0; i < keysCount; ++i)
+    {
+        const auto data = pool.Add(keys[i].data(), keys[i].size());
+        EXPECT_EQ(keys[i], data.str);
+        // the string which was interned before the loading keeps its id and shifts the preceding ones
+        const int expectedId = i < 7 ? i + 1 : (i == 7 ? 0 : i);
+        EXPECT_EQ(expectedId, data.entry->id.value);
+    }
+    EXPECT_EQ(existing.str, pool.Add("StringPoolTest.Snapshot.7", 25).str);
+    EXPECT_EQ(keysCount, pool.GetStatistics().atomsCount);
+}
+
+TEST(StringPoolTest, SnapshotOfWrongFile)
+{
+    const auto path = std::filesystem::temp_directory_path() / "StringPoolTest.SnapshotOfWrongFile.bin";
+
+    Core::_StringPool<char> pool;
+    EXPECT_FALSE(pool.LoadSnapshot(path));
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "definitely not a snapshot of the string pool";
+    }
+    EXPECT_FALSE(pool.LoadSnapshot(path));
+
+    Core::_StringPool<wchar_t> wpool;
+    (void)wpool.Add(L"Hello", 5);
+    ASSERT_TRUE(wpool.SaveSnapshot(path));
+    EXPECT_FALSE(pool.LoadSnapshot(path));
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(0, pool.GetStatistics().atomsCount);
+}
+
+TEST(StringPoolTest, SnapshotOfReclaimablePool)
+{
+    using Pool = Core::_StringPool<char>;
+    const auto path = std::filesystem::temp_directory_path() / "StringPoolTest.SnapshotOfReclaimablePool.bin";
+
+    {
+        Pool pool;
+        pool.SetCollectThreshold(0);
+        (void)pool.Add("Pinned", 6);
+        pool.SetReclaimable(true);
+        const auto dropped = pool.Add("Dropped", 7);
+        const auto freed = pool.Add("Freed", 5);
+        (void)pool.Add("Kept", 4);
+        Pool::Release(*freed.entry);
+        EXPECT_EQ(1, pool.Collect());
+        Pool::Release(*dropped.entry);
+
+        ASSERT_TRUE(pool.SaveSnapshot(path));
+    }
+
+    Pool pool;
+    ASSERT_TRUE(pool.LoadSnapshot(path));
+    EXPECT_EQ(2, pool.GetStatistics().atomsCount);
+    // the gap of the freed id is closed
+    EXPECT_EQ(0, pool.Add("Pinned", 6).entry->id.value);
+    EXPECT_EQ(1, pool.Add("Kept", 4).entry->id.value);
+
+    // strings are freed by another thread while the snapshots are written
+    Pool reclaimable;
+    reclaimable.SetReclaimable(true);
+    reclaimable.SetCollectThreshold(1);
+    std::atomic<bool> isDone = false;
+    std::thread writer([&reclaimable, &isDone]() {
+        for (int i = 0; !isDone.load(); ++i)
+        {
+            const auto key = "StringPoolTest.SnapshotOfReclaimablePool." + std::to_string(i % 100);
+            Pool::Release(*reclaimable.Add(key.data(), key.size()).entry);
+        }
+    });
+    for (int i = 0; i < 50; ++i)
+    {
+        EXPECT_TRUE(reclaimable.SaveSnapshot(path));
+    }
+    isDone = true;
+    writer.join();
+    std::filesystem::remove(path);
+}
+
+TEST(StringPoolTest, ThreadCache)
+{
+    using Pool = Core::_StringPool<char>;
+
+    CollidingPool pool;
+    EXPECT_FALSE(pool.IsThreadCacheEnabled());
+
+    Pool::ResetThreadCacheStatistics();
+    (void)pool.Add("Hello", 5);
+    (void)pool.Add("Hello", 5);
+    EXPECT_EQ(0, Pool::GetThreadCacheStatistics().hitsCount);
+    EXPECT_EQ(0, Pool::GetThreadCacheStatistics().missesCount);
+
+    pool.SetThreadCacheEnabled(true);
+    const auto first = pool.Add("Hello", 5);
+    const auto second = pool.Add("Hello", 5);
+    const auto third = pool.Add("Hello", 5);
+    EXPECT_EQ(first.str, second.str);
+    EXPECT_EQ(first.entry, third.entry);
+    EXPECT_EQ(2, Pool::GetThreadCacheStatistics().hitsCount);
+    EXPECT_EQ(1, Pool::GetThreadCacheStatistics().missesCount);
+
+    // the same hash, but another string
+    const auto collision = pool.AddWithHash("World", 5, first.entry->hash);
+    EXPECT_STREQ("World", collision.str);
+    EXPECT_EQ(2, Pool::GetThreadCacheStatistics().hitsCount);
+
+    // a cached entry of one pool is never returned by another one
+    Pool otherPool;
+    otherPool.SetThreadCacheEnabled(true);
+    const auto other = otherPool.Add("World", 5);
+    EXPECT_NE(collision.str, other.str);
+
+    std::thread([&pool]() {
+        (void)pool.Add("Hello", 5);
+        EXPECT_EQ(0, Pool::GetThreadCacheStatistics().hitsCount);
+        EXPECT_EQ(1, Pool::GetThreadCacheStatistics().missesCount);
+    }).join();
+}
+
+TEST(StringPoolTest, Reclaimable)
+{
+    using Pool = Core::_StringPool<char>;
+
+    Pool pool;
+    pool.SetCollectThreshold(0);
+    const auto pinned = pool.Add("Pinned", 6);
+    pool.SetReclaimable(true);
+    EXPECT_TRUE(pool.IsReclaimable());
+
+    const auto literal = pool.Add("Literal", 7, true);
+    const auto first = pool.Add("Transient", 9);
+    const auto second = pool.Add("Transient", 9);
+    EXPECT_EQ(first.entry, second.entry);
+    EXPECT_EQ(2, first.entry->refs.load());
+    EXPECT_EQ(3, pool.GetStatistics().atomsCount);
+
+    Pool::Release(*first.entry);
+    EXPECT_EQ(0, pool.Collect());
+    EXPECT_EQ("Transient", pool.GetView(first.entry->id));
+
+    const auto id = first.entry->id;
+    Pool::Release(*second.entry);
+    EXPECT_EQ(1, pool.Collect());
+    EXPECT_EQ(2, pool.GetStatistics().atomsCount);
+    EXPECT_EQ(nullptr, pool.Resolve(id).str);
+
+    // pinned strings survive without references
+    Pool::Release(*pinned.entry);
+    Pool::Release(*literal.entry);
+    EXPECT_EQ(0, pool.Collect());
+    EXPECT_EQ("Pinned", pool.GetView(pinned.entry->id));
+    EXPECT_EQ("Literal", pool.GetView(literal.entry->id));
+
+    // the id of the freed string is reused
+    const auto other = pool.Add("Another transient", 17);
+    EXPECT_EQ(id, other.entry->id);
+    EXPECT_EQ("Another transient", pool.GetView(id));
+}
+
+TEST(StringPoolTest, ReclaimableCollectThreshold)
+{
+    using Pool = Core::_StringPool<char>;
+
+    Pool pool;
+    pool.SetReclaimable(true);
+    pool.SetCollectThreshold(64);
+    Core::AtomId maxId{ 0 };
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto key = std::to_string(i);
+        const auto data = pool.Add(key.data(), key.size());
+        maxId = std::max(maxId, data.entry->id);
+        Pool::Release(*data.entry);
+    }
+
+    // the freed ids are reused, so the directory doesn't grow
+    EXPECT_GT(64, pool.GetStatistics().atomsCount);
+    EXPECT_GT(64, maxId.value);
+}
+
+TEST(StringPoolTest, ReclaimableAtoms)
+{
+    using Core::StringAtom;
+
+    auto& pool = Core::_StringPool<char>::Instance();
+    pool.SetReclaimable(true);
+    pool.SetCollectThreshold(0);
+
+    const auto statistics = pool.GetStatistics();
+    {
+        auto atom = StringAtom::Intern("StringPoolTest.ReclaimableAtoms");
+        const auto id = atom.GetAtomId();
+        {
+            const auto copy = atom;
+            auto moved = StringAtom::FromAtomId(id);
+            EXPECT_EQ(atom, copy);
+            EXPECT_EQ(atom, moved);
+            moved.PushBack('!');
+        }
+        pool.Collect();
+        EXPECT_EQ("StringPoolTest.ReclaimableAtoms", pool.GetView(id));
+        EXPECT_EQ(statistics.atomsCount + 1, pool.GetStatistics().atomsCount);
+    }
+    pool.Collect();
+    EXPECT_EQ(statistics.atomsCount, pool.GetStatistics().atomsCount);
+
+    // literals stay pinned
+    {
+        const auto literal = "StringPoolTest.ReclaimableAtoms.Literal"_atom;
+        EXPECT_TRUE(literal.GetAtomId().IsValid());
+    }
+    pool.Collect();
+    EXPECT_EQ(statistics.atomsCount + 1, pool.GetStatistics().atomsCount);
+
+    pool.SetReclaimable(false);
+}
+
+TEST(StringPoolTest, AddBatch)
+{
+    Core::_StringPool<char> pool;
+    const auto existing = pool.Add("existing", 8);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i)
+    {
+        keys.push_back("StringPoolTest.AddBatch." + std::to_string(i % 700));
+    }
+    keys.push_back("existing");
+
+    const std::vector<std::string_view> views(keys.begin(), keys.end());
+    std::vector<Core::StringDataReadOnly<char>> out(views.size());
+    pool.AddBatch(views, out);
+
+    EXPECT_EQ(701, pool.GetStatistics().atomsCount);
+    EXPECT_EQ(existing.str, out.back().str);
+    for (std::size_t i = 0; i < views.size(); ++i)
+    {
+        EXPECT_EQ(views[i], out[i].str);
+        EXPECT_EQ(pool.Add(views[i].data(), views[i].size()).entry, out[i].entry);
+    }
+}
+
+TEST(StringPoolTest, InternBatch)
+{
+    using Core::StringAtom;
+
+    const std::vector<std::string_view> views = { "StringPoolTest.InternBatch.First", "StringPoolTest.InternBatch.Second",
+                                                  "StringPoolTest.InternBatch.First" };
+    std::vector<StringAtom> atoms(views.size());
+    StringAtom::InternBatch(views, atoms);
+
+    EXPECT_TRUE(atoms[0].IsStatic());
+    EXPECT_EQ(atoms[0].c_str(), atoms[2].c_str());
+    EXPECT_EQ(StringAtom::Intern(views[1]).c_str(), atoms[1].c_str());
+}
+
+TEST(StringPoolTest, ScopedPool)
+{
+    using Core::StringAtom;
+
+    const auto global = StringAtom::Intern("StringPoolTest.ScopedPool");
+    {
+        Core::StringAtomPool pool;
+        const auto first = StringAtom::Intern(pool, "StringPoolTest.ScopedPool");
+        const auto second = StringAtom::Intern(pool, std::string_view("StringPoolTest.ScopedPool"));
+
+        EXPECT_TRUE(first.IsStatic());
+        EXPECT_EQ(first.c_str(), second.c_str());
+        EXPECT_TRUE(first.IsFromSamePool(second));
+        EXPECT_EQ(first, second);
+
+        // atoms of different pools are compared by the characters
+        EXPECT_NE(global.c_str(), first.c_str());
+        EXPECT_FALSE(global.IsFromSamePool(first));
+        EXPECT_EQ(global, first);
+        EXPECT_NE(global, StringAtom::Intern(pool, "StringPoolTest.ScopedPool.Other"));
+
+        EXPECT_EQ(first.c_str(), StringAtom::FromAtomId(pool, first.GetAtomId()).c_str());
+        EXPECT_EQ(2, pool.GetStatistics().atomsCount);
+
+        const std::vector<std::string_view> views = { "StringPoolTest.ScopedPool", "StringPoolTest.ScopedPool.Batch" };
+        std::vector<StringAtom> atoms(views.size());
+        StringAtom::InternBatch(pool, views, atoms);
+        EXPECT_EQ(first.c_str(), atoms[0].c_str());
+        EXPECT_EQ(3, pool.GetStatistics().atomsCount);
+    }
+
+    EXPECT_EQ("StringPoolTest.ScopedPool", global);
+}
@@ -22,10 +22,43 @@
 
 #include "Core/String.h"
 
+#include <algorithm>
+#include <cctype>
+#include <compare>
+#include <cwctype>
 #include <filesystem>
 #include <fstream>
 #include <gtest/gtest.h>
+#include <memory_resource>
+#include <random>
+#include <thread>
 #include <unordered_set>
+#include <vector>
+
+namespace
+{
+    class CountingMemoryResource final : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t allocationsCount = 0;
+        std::size_t deallocationsCount = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocationsCount;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            ++deallocationsCount;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+} // namespace
 
 TEST(StringTest, BaseString_char_default__Creation)
 {
@@ -228,6 +261,35 @@ TEST(StringTest, BaseString_char_default__Comparision)
         EXPECT_TRUE("Hello1"_atom >= std::string("Hello").data());
         EXPECT_TRUE("Hello"_atom <= std::string_view("Hello1").data());
     }
+    {
+        // the sizes take part, so embedded zeros and prefixes are compared like std::string does
+        const StringAtom withZero{ std::string_view("AA\0B", 4) };
+        const StringAtom prefix{ std::string_view("AA", 2) };
+        EXPECT_TRUE(prefix < withZero);
+        EXPECT_TRUE(withZero != prefix);
+        EXPECT_TRUE(withZero != "AA");
+        EXPECT_TRUE(withZero == std::string_view("AA\0B", 4));
+        EXPECT_TRUE(std::string_view("AA\0C", 4) > withZero);
+        EXPECT_TRUE(std::strong_ordering::less == (prefix <=> withZero));
+        EXPECT_TRUE(std::strong_ordering::equal == ("AAA"_atom <=> "AAA"));
+        EXPECT_EQ(Core::Comparison::Less, prefix.Compare(std::string_view("AA\0B", 4)));
+        EXPECT_TRUE(StringAtom() == StringAtom());
+        EXPECT_TRUE(StringAtom() < "A"_atom);
+
+        std::vector<std::string> expected = { "b", "a", "ab", "A", "aa", "a b", std::string("a\0b", 3), "ba" };
+        std::vector<StringAtom> strings;
+        for (const auto& string : expected)
+        {
+            strings.emplace_back(std::string_view(string));
+        }
+        std::ranges::sort(expected);
+        std::ranges::sort(strings);
+        ASSERT_EQ(expected.size(), strings.size());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            EXPECT_TRUE(strings[i] == std::string_view(expected[i]));
+        }
+    }
 }
 
 TEST(StringTest, BaseString_char_default__InStdSet)
@@ -496,7 +558,10 @@ TEST(StringTest, BaseString_char_default_Cmp)
     {
         const auto str = "Hello world!"_atom;
         EXPECT_TRUE(str.Compare("hello world!", true) == Core::Comparison::Equal);
-        EXPECT_TRUE(str.Compare("hello world", true) == Core::Comparison::Less);
+        EXPECT_TRUE(str.Compare("hello world", true) == Core::Comparison::Greater);
+        EXPECT_TRUE(str.Compare("hello world!!", true) == Core::Comparison::Less);
+        EXPECT_TRUE(str.IsEqualIgnoreCase("HELLO WORLD!"));
+        EXPECT_FALSE(str.IsEqualIgnoreCase("HELLO WORLD"));
     }
 
     {
@@ -821,6 +886,39 @@ TEST(StringTest, BaseString_char_default_Replace)
         str.ReplaceAll("o", "!o!");
         EXPECT_EQ("Hell!o! W!o!rld! Hell!o! W!o!rld!", str);
     }
+
+    {
+        auto str = "aaaaa"_atom;
+        str.ReplaceAll("aa", "b");
+        EXPECT_EQ("bba", str);
+        EXPECT_EQ(3, str.Size());
+
+        str.ReplaceAll("c", "d");
+        EXPECT_EQ("bba", str);
+
+        str.ReplaceAll("b", "");
+        EXPECT_EQ("a", str);
+    }
+
+    {
+        // the new value points into the string itself
+        auto str = "x-x-x"_atom;
+        str.ReplaceAll("x", str);
+        EXPECT_EQ("x-x-x-x-x-x-x-x-x", str);
+    }
+
+    {
+        auto str = "<a href=\"x\">&</a>"_atom;
+        str.ReplaceMany({ { "&", "&amp;" }, { "<", "&lt;" }, { ">", "&gt;" }, { "\"", "&quot;" } });
+        EXPECT_EQ("&lt;a href=&quot;x&quot;&gt;&amp;&lt;/a&gt;", str);
+    }
+
+    {
+        // the first pattern of the list wins at a position and the inserted values aren't replaced again
+        auto str = "{name} is {age}, {{name}}"_atom;
+        str.ReplaceMany({ { "{name}", "{age}" }, { "{age}", "42" }, { "{n", "-" } });
+        EXPECT_EQ("{age} is 42, {{age}}", str);
+    }
 }
 
 TEST(StringTest, BaseString_char_default_Regex)
@@ -1131,6 +1229,437 @@ TEST(StringTest, BaseString_char_default__Misc)
     EXPECT_FALSE(Core::StringAtom::IsContainChar('z', "abcdef"));
 }
 
+TEST(StringTest, BaseString_char_default__CompileTimeLiteral)
+{
+    using Core::StringAtom;
+
+    constexpr auto hash = Core::_StringHasher<char>::Hash("Hello world, compile time!", 26);
+    const std::string runtimeString = "Hello world, compile time!";
+    EXPECT_EQ(hash, Core::_StringHasher<char>::Hash(runtimeString.data(), runtimeString.size()));
+
+    const auto charsCount = Core::_StringPool<char>::Instance().GetStatistics().charsCount;
+    const auto str1 = "StringTest.CompileTimeLiteral.NotCopied"_atom;
+    const auto str2 = "StringTest.CompileTimeLiteral.NotCopied"_atom;
+    EXPECT_EQ(charsCount, Core::_StringPool<char>::Instance().GetStatistics().charsCount);
+    EXPECT_TRUE(str1.IsStatic());
+    EXPECT_EQ(str1.c_str(), str2.c_str());
+    EXPECT_EQ(str1.c_str(), StringAtom::Intern(std::string("StringTest.CompileTimeLiteral.NotCopied")).c_str());
+    EXPECT_EQ("StringTest.CompileTimeLiteral.NotCopied", str1);
+}
+
+TEST(StringTest, BaseString_char_default__Hash)
+{
+    using Core::StringAtom;
+
+    const auto atom = "StringTest.Hash"_atom;
+    const StringAtom dynamic = "StringTest.Hash";
+    EXPECT_EQ(Core::_StringHasher<char>::Hash("StringTest.Hash", 15), atom.MakeHash());
+    EXPECT_EQ(atom.MakeHash(), dynamic.MakeHash());
+    EXPECT_EQ(atom.MakeHash(), std::hash<StringAtom>{}(dynamic));
+
+    StringAtom modified = dynamic;
+    modified.PushBack('!');
+    EXPECT_EQ(Core::_StringHasher<char>::Hash("StringTest.Hash!", 16), modified.MakeHash());
+    modified.PopBack();
+    EXPECT_EQ(atom.MakeHash(), modified.MakeHash());
+    modified.ToUpperCase();
+    EXPECT_EQ(Core::_StringHasher<char>::Hash("STRINGTEST.HASH", 15), modified.MakeHash());
+    modified = atom;
+    EXPECT_EQ(atom.MakeHash(), modified.MakeHash());
+
+    {
+        StringAtom first = "StringTest.Hash.First";
+        StringAtom second = "StringTest.Hash.Second";
+        (void)first.MakeHash();
+        (void)second.MakeHash();
+        const StringAtom firstMoved = std::move(first);
+        const StringAtom secondMoved = std::move(second);
+        EXPECT_TRUE(first.IsEmpty());
+        EXPECT_TRUE(first == second);
+        EXPECT_NE(firstMoved, secondMoved);
+    }
+
+    // a const string is hashed and compared by several threads at once
+    const StringAtom shared = "StringTest.Hash.Shared";
+    const auto expected = Core::_StringHasher<char>::Hash("StringTest.Hash.Shared", 22);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&shared, &dynamic, expected]() {
+            for (int j = 0; j < 1000; ++j)
+            {
+                EXPECT_EQ(expected, shared.MakeHash());
+                EXPECT_NE(shared, dynamic);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST(StringTest, BaseString_char_default__SmallStringOptimization)
+{
+    using Core::StringAtom;
+
+    const std::string shortString(StringAtom::inlineCapacity - 1, 'a');
+    const std::string longString(StringAtom::inlineCapacity, 'b');
+
+    StringAtom str = shortString.c_str();
+    EXPECT_TRUE(str.IsInline());
+    EXPECT_EQ(StringAtom::inlineCapacity, str.Capacity());
+    EXPECT_EQ(shortString, str.c_str());
+
+    StringAtom copy = str;
+    EXPECT_TRUE(copy.IsInline());
+    EXPECT_EQ(str, copy);
+
+    StringAtom moved = std::move(copy);
+    EXPECT_TRUE(moved.IsInline());
+    EXPECT_EQ(shortString, moved.c_str());
+
+    str.PushBack('b');
+    EXPECT_FALSE(str.IsInline());
+    EXPECT_EQ(shortString + "b", str.c_str());
+    str.Reserve(1);
+    EXPECT_TRUE(str.IsInline());
+    EXPECT_EQ("a", str);
+
+    EXPECT_FALSE(StringAtom(longString.c_str()).IsInline());
+    EXPECT_FALSE(StringAtom::Intern(shortString).IsInline());
+
+    auto atom = StringAtom::Intern(shortString);
+    atom.PushBack('c');
+    EXPECT_EQ(shortString + "c", atom.c_str());
+    atom.PopBack();
+    atom.PopBack();
+    atom.Reserve(atom.Size());
+    EXPECT_TRUE(atom.IsInline());
+    EXPECT_EQ(shortString.substr(1), atom.c_str());
+}
+
+TEST(StringTest, BaseString_char_default__MemoryResource)
+{
+    using Core::StringAtom;
+
+    const std::string longString(StringAtom::inlineCapacity * 4, 'a');
+    CountingMemoryResource resource;
+    {
+        StringAtom str(longString, &resource);
+        EXPECT_EQ(&resource, str.GetMemoryResource());
+        EXPECT_EQ(1, resource.allocationsCount);
+
+        StringAtom moved = std::move(str);
+        EXPECT_EQ(&resource, moved.GetMemoryResource());
+        EXPECT_EQ(1, resource.allocationsCount);
+
+        StringAtom copy = moved;
+        EXPECT_EQ(nullptr, copy.GetMemoryResource());
+        EXPECT_EQ(1, resource.allocationsCount);
+
+        StringAtom other(&resource);
+        other = std::move(copy);
+        EXPECT_EQ(2, resource.allocationsCount);
+        EXPECT_EQ(longString, other.c_str());
+
+        StringAtom shortString("abc", &resource);
+        EXPECT_TRUE(shortString.IsInline());
+        EXPECT_EQ(2, resource.allocationsCount);
+    }
+    EXPECT_EQ(resource.allocationsCount, resource.deallocationsCount);
+
+    std::pmr::monotonic_buffer_resource arena;
+    StringAtom str(&arena);
+    for (const auto ch : longString)
+    {
+        str.PushBack(ch);
+    }
+    EXPECT_EQ(longString, str.c_str());
+}
+
+TEST(StringTest, BaseString_char_default__Append)
+{
+    using Core::StringAtom;
+
+    StringAtom str;
+    for (int i = 0; i < 100; ++i)
+    {
+        str.PushBack('a');
+        EXPECT_LT(str.Size(), str.Capacity());
+        EXPECT_EQ(0, str.c_str()[str.Size()]);
+    }
+    EXPECT_EQ(std::string(100, 'a'), str.c_str());
+
+    // the appended characters are a part of the string which is reallocated
+    str = StringAtom("abcdefghijklmnopqrstuvwxyz");
+    str.ShrinkToFit();
+    str += str.ToStringView();
+    EXPECT_EQ("abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz", str);
+
+    const auto capacity = str.Capacity();
+    str.Resize(4);
+    str.Resize(6);
+    EXPECT_EQ(capacity, str.Capacity());
+    EXPECT_EQ(6, str.Size());
+    EXPECT_EQ(0, str[4]);
+    EXPECT_EQ(0, str[5]);
+    EXPECT_EQ(0, str.c_str()[6]);
+
+    auto atom = StringAtom::Intern("STRINGTEST.APPEND");
+    atom += "";
+    EXPECT_TRUE(atom.IsStatic());
+    atom += "!";
+    EXPECT_TRUE(atom.IsDynamic());
+    EXPECT_EQ("STRINGTEST.APPEND!", atom);
+    EXPECT_EQ("STRINGTEST.APPEND", StringAtom::Intern("STRINGTEST.APPEND"));
+}
+
+TEST(StringTest, BaseString_char_default__StrCat)
+{
+    using Core::StringAtom;
+
+    const auto atom = StringAtom::Intern("key");
+    const StringAtom dynamic = "value";
+    const std::string stdString = "std";
+    const auto str = Core::StrCat(atom, '=', dynamic, " ", stdString, ' ', 42, ' ', -7ll, ' ', 0.5);
+    EXPECT_TRUE((std::is_same_v<std::remove_cvref_t<decltype(str)>, StringAtom>));
+    EXPECT_EQ("key=value std 42 -7 0.5", str);
+    EXPECT_EQ(str.Size() + 1, str.Capacity());
+
+    EXPECT_TRUE(Core::StrCat<char>().IsEmpty());
+    EXPECT_EQ("1x", Core::StrCat<char>(1, 'x'));
+
+    const std::vector<StringAtom> words = { "one", "two", "three" };
+    EXPECT_EQ("one, two, three", Core::Join(words, ", "));
+    EXPECT_EQ("1-2-3", Core::Join<char>(std::vector<int>{ 1, 2, 3 }, '-'));
+    EXPECT_TRUE(Core::Join(std::vector<StringAtom>{}, ", ").IsEmpty());
+
+    StringAtom erased = "Hello World";
+    erased.Erase(5);
+    EXPECT_EQ("HelloWorld", erased);
+}
+
+TEST(StringTest, BaseString_char_default__CopyOnWrite)
+{
+    using Core::StringAtom;
+
+    const StringAtom original = "A string which doesn't fit the inline buffer";
+    const std::string_view text = original.ToStringView();
+
+    {
+        StringAtom copy = original;
+        copy.PushBack('!');
+        copy.Data()[0] = 'a';
+        EXPECT_EQ(text, original.ToStringView());
+        EXPECT_EQ("a string which doesn't fit the inline buffer!", copy);
+    }
+
+    {
+        StringAtom copy = original;
+        copy.ToUpperCase();
+        EXPECT_EQ(text, original.ToStringView());
+        EXPECT_EQ("A STRING WHICH DOESN'T FIT THE INLINE BUFFER", copy);
+    }
+
+    {
+        StringAtom copy = original;
+        copy.TrimEnd('r');
+        copy.PushFront("> ");
+        copy.Insert(0, "<");
+        EXPECT_EQ(text, original.ToStringView());
+        EXPECT_EQ("<> A string which doesn't fit the inline buffe", copy);
+    }
+
+    {
+        StringAtom copy = original;
+        copy = std::string_view("Another string which doesn't fit the inline buffer");
+        copy.PopBack();
+        EXPECT_EQ(text, original.ToStringView());
+        EXPECT_EQ("Another string which doesn't fit the inline buffe", copy);
+    }
+
+    {
+        // the buffer of a grown string has room for the appended characters
+        StringAtom grown;
+        for (const auto ch : std::string_view("twenty characters..."))
+        {
+            grown.PushBack(ch);
+        }
+        ASSERT_GT(grown.Capacity(), grown.Size() + 2);
+
+        StringAtom pushedChar = grown;
+        pushedChar.PushBack('Y');
+        EXPECT_EQ(21, pushedChar.Size());
+        EXPECT_EQ("twenty characters...Y", pushedChar.ToStringView());
+
+        StringAtom pushedView = grown;
+        pushedView.PushBack("ZZ");
+        EXPECT_EQ(22, pushedView.Size());
+        EXPECT_EQ("twenty characters...ZZ", pushedView.ToStringView());
+
+        StringAtom pushedFront = grown;
+        pushedFront.PushFront('P');
+        EXPECT_EQ(21, pushedFront.Size());
+        EXPECT_EQ("Ptwenty characters...", pushedFront.ToStringView());
+
+        StringAtom inserted = grown;
+        inserted.Insert(0, "Q");
+        EXPECT_EQ(21, inserted.Size());
+        EXPECT_EQ("Qtwenty characters...", inserted.ToStringView());
+
+        EXPECT_EQ("twenty characters...", grown.ToStringView());
+    }
+
+    {
+        // the characters written through the pointer given out by Data() don't get into the later copies
+        StringAtom leaked = original;
+        auto* characters = leaked.Data();
+        const StringAtom copy = leaked;
+        characters[0] = 'X';
+        EXPECT_EQ('X', leaked[0]);
+        EXPECT_EQ('A', copy[0]);
+        EXPECT_EQ(text, original.ToStringView());
+
+        StringAtom moved = std::move(leaked);
+        const StringAtom movedCopy = moved;
+        characters[1] = 'Y';
+        EXPECT_EQ('Y', moved[1]);
+        EXPECT_EQ(' ', movedCopy[1]);
+    }
+
+#ifdef CORE_STRING_COPY_ON_WRITE
+    {
+        StringAtom copy = original;
+        EXPECT_TRUE(copy.IsBufferShared());
+        EXPECT_TRUE(original.IsBufferShared());
+        EXPECT_EQ(original.c_str(), copy.c_str());
+
+        copy.PushBack('!');
+        EXPECT_FALSE(copy.IsBufferShared());
+        EXPECT_FALSE(original.IsBufferShared());
+        EXPECT_NE(original.c_str(), copy.c_str());
+    }
+
+    CountingMemoryResource resource;
+    {
+        const StringAtom source(text, &resource);
+        StringAtom copy(&resource);
+        copy = source;
+        EXPECT_TRUE(copy.IsBufferShared());
+        EXPECT_EQ(1, resource.allocationsCount);
+
+        // a copy which uses another resource never refers to the buffer
+        const StringAtom heapCopy = source;
+        EXPECT_FALSE(heapCopy.IsBufferShared());
+    }
+    EXPECT_EQ(1, resource.deallocationsCount);
+#endif
+}
+
+TEST(StringTest, BaseString_char_default__FindLong)
+{
+    using Core::StringAtom;
+
+    // sizes around the vector width, needles at the edges and embedded zeros
+    std::mt19937 random(7);
+    for (std::size_t size = 1; size < 200; ++size)
+    {
+        std::string text(size, 'a');
+        for (auto& ch : text)
+        {
+            ch = static_cast<char>(random() % 3 == 0 ? 0 : 'a' + random() % 3);
+        }
+        const StringAtom str{std::string_view(text)};
+
+        for (std::size_t needleSize = 1; needleSize <= std::min<std::size_t>(size, 6); ++needleSize)
+        {
+            const std::string needle = text.substr(random() % (size - needleSize + 1), needleSize);
+
+            std::vector<std::size_t> expected;
+            for (auto offset = text.find(needle); offset != std::string::npos; offset = text.find(needle, offset + 1))
+            {
+                expected.push_back(offset);
+            }
+
+            ASSERT_EQ(expected, str.FindAllOffsets(needle));
+            ASSERT_EQ(str.c_str() + expected.front(), str.Find(needle));
+        }
+    }
+
+    const StringAtom str = "aaaa";
+    EXPECT_EQ((std::vector<std::size_t>{ 0, 1, 2 }), str.FindAllOffsets("aa"));
+    EXPECT_EQ(nullptr, str.Find("aaaaa"));
+    EXPECT_EQ(str.c_str() + 3, str.Find("a", 3));
+    EXPECT_EQ(nullptr, str.Find("a", 4));
+
+    const std::string haystack = std::string(1 << 16, 'x') + "needle";
+    const StringAtom big{std::string_view(haystack)};
+    EXPECT_EQ(big.c_str() + (1 << 16), big.Find("needle"));
+
+    int count = 0;
+    big.IterateFind("xx", [&count](std::size_t) { return ++count < 10; });
+    EXPECT_EQ(10, count);
+}
+
+TEST(StringTest, BaseString_char_default__CaseLong)
+{
+    using Core::StringAtom;
+
+    const auto toUpper = [](char ch) { return static_cast<char>(std::toupper(static_cast<unsigned char>(ch))); };
+    const auto toLower = [](char ch) { return static_cast<char>(std::tolower(static_cast<unsigned char>(ch))); };
+    const auto compare = [&toUpper](std::string_view first, std::string_view second) {
+        for (std::size_t i = 0; i < std::min(first.size(), second.size()); ++i)
+        {
+            const auto ch = static_cast<unsigned char>(toUpper(first[i]));
+            const auto otherCh = static_cast<unsigned char>(toUpper(second[i]));
+            if (ch != otherCh)
+            {
+                return ch < otherCh ? Core::Comparison::Less : Core::Comparison::Greater;
+            }
+        }
+        if (first.size() == second.size())
+        {
+            return Core::Comparison::Equal;
+        }
+        return first.size() < second.size() ? Core::Comparison::Less : Core::Comparison::Greater;
+    };
+
+    // sizes around the vector width, the letters at the edges of the ranges, non-ASCII characters in some of the vectors
+    std::mt19937 random(11);
+    const std::string alphabet = "aAzZ@[`{_09\xE9\xC0";
+    for (std::size_t size = 1; size < 100; ++size)
+    {
+        const bool isAscii = random() % 2 == 0;
+        std::string text(size, 'a');
+        for (auto& ch : text)
+        {
+            ch = alphabet[random() % (isAscii ? alphabet.size() - 2 : alphabet.size())];
+        }
+
+        std::string upper = text;
+        std::string lower = text;
+        std::ranges::transform(upper, upper.begin(), toUpper);
+        std::ranges::transform(lower, lower.begin(), toLower);
+
+        auto str = StringAtom{ std::string_view(text) };
+        str.ToUpperCase();
+        ASSERT_EQ(upper, str);
+        str.ToLowerCase();
+        ASSERT_EQ(lower, str);
+
+        const StringAtom original{ std::string_view(text) };
+        ASSERT_TRUE(original.IsEqualIgnoreCase(upper));
+        ASSERT_EQ(Core::Comparison::Equal, original.Compare(lower, true));
+
+        std::string other = lower;
+        other[random() % size] = alphabet[random() % alphabet.size()];
+        ASSERT_EQ(compare(text, other), original.Compare(other, true));
+        ASSERT_EQ(compare(text, other) == Core::Comparison::Equal, original.IsEqualIgnoreCase(other));
+        ASSERT_EQ(Core::Comparison::Less, original.Compare(upper + "a", true));
+    }
+}
 
 // =================================================================
 // ========================== WCHAR_T ==============================
@@ -1213,7 +1742,11 @@ TEST(StringTest, BaseString_wchar_t_default__DefaultCopyAndMove)
 
         ASSERT_FALSE(str1.IsEmpty());
         ASSERT_FALSE(str2.IsEmpty());
+#ifdef CORE_STRING_COPY_ON_WRITE
+        EXPECT_EQ(str1.CStr(), str2.CStr());
+#else
         EXPECT_NE(str1.CStr(), str2.CStr());
+#endif
         EXPECT_TRUE(str1.IsDynamic());
         EXPECT_TRUE(str2.IsDynamic());
         EXPECT_EQ(5, str1.Size());
@@ -1329,6 +1862,35 @@ TEST(StringTest, BaseString_wchar_t_default__Comparision)
         EXPECT_TRUE(L"Hello1"_atom >= std::wstring(L"Hello").data());
         EXPECT_TRUE(L"Hello"_atom <= std::wstring_view(L"Hello1").data());
     }
+    {
+        // the sizes take part, so embedded zeros and prefixes are compared like std::wstring does
+        const WStringAtom withZero{ std::wstring_view(L"AA\0B", 4) };
+        const WStringAtom prefix{ std::wstring_view(L"AA", 2) };
+        EXPECT_TRUE(prefix < withZero);
+        EXPECT_TRUE(withZero != prefix);
+        EXPECT_TRUE(withZero != L"AA");
+        EXPECT_TRUE(withZero == std::wstring_view(L"AA\0B", 4));
+        EXPECT_TRUE(std::wstring_view(L"AA\0C", 4) > withZero);
+        EXPECT_TRUE(std::strong_ordering::less == (prefix <=> withZero));
+        EXPECT_TRUE(std::strong_ordering::equal == (L"AAA"_atom <=> L"AAA"));
+        EXPECT_EQ(Core::Comparison::Less, prefix.Compare(std::wstring_view(L"AA\0B", 4)));
+        EXPECT_TRUE(WStringAtom() == WStringAtom());
+        EXPECT_TRUE(WStringAtom() < L"A"_atom);
+
+        std::vector<std::wstring> expected = { L"b", L"a", L"ab", L"A", L"aa", L"a b", std::wstring(L"a\0b", 3), L"ba" };
+        std::vector<WStringAtom> strings;
+        for (const auto& string : expected)
+        {
+            strings.emplace_back(std::wstring_view(string));
+        }
+        std::ranges::sort(expected);
+        std::ranges::sort(strings);
+        ASSERT_EQ(expected.size(), strings.size());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            EXPECT_TRUE(strings[i] == std::wstring_view(expected[i]));
+        }
+    }
 }
 
 TEST(StringTest, BaseString_wchar_t_default__InStdSet)
@@ -1579,7 +2141,10 @@ TEST(StringTest, BaseString_wchar_t_default_Cmp)
     {
         const auto str = L"Hello world!"_atom;
         EXPECT_TRUE(str.Compare(L"hello world!", true) == Core::Comparison::Equal);
-        EXPECT_TRUE(str.Compare(L"hello world", true) == Core::Comparison::Less);
+        EXPECT_TRUE(str.Compare(L"hello world", true) == Core::Comparison::Greater);
+        EXPECT_TRUE(str.Compare(L"hello world!!", true) == Core::Comparison::Less);
+        EXPECT_TRUE(str.IsEqualIgnoreCase(L"HELLO WORLD!"));
+        EXPECT_FALSE(str.IsEqualIgnoreCase(L"HELLO WORLD"));
     }
 
     {
@@ -1904,6 +2469,39 @@ TEST(StringTest, BaseString_wchar_t_default_Replace)
         str.ReplaceAll(L"o", L"!o!");
         EXPECT_EQ(L"Hell!o! W!o!rld! Hell!o! W!o!rld!", str);
     }
+
+    {
+        auto str = L"aaaaa"_atom;
+        str.ReplaceAll(L"aa", L"b");
+        EXPECT_EQ(L"bba", str);
+        EXPECT_EQ(3, str.Size());
+
+        str.ReplaceAll(L"c", L"d");
+        EXPECT_EQ(L"bba", str);
+
+        str.ReplaceAll(L"b", L"");
+        EXPECT_EQ(L"a", str);
+    }
+
+    {
+        // the new value points into the string itself
+        auto str = L"x-x-x"_atom;
+        str.ReplaceAll(L"x", str);
+        EXPECT_EQ(L"x-x-x-x-x-x-x-x-x", str);
+    }
+
+    {
+        auto str = L"<a href=\"x\">&</a>"_atom;
+        str.ReplaceMany({ { L"&", L"&amp;" }, { L"<", L"&lt;" }, { L">", L"&gt;" }, { L"\"", L"&quot;" } });
+        EXPECT_EQ(L"&lt;a href=&quot;x&quot;&gt;&amp;&lt;/a&gt;", str);
+    }
+
+    {
+        // the first pattern of the list wins at a position and the inserted values aren't replaced again
+        auto str = L"{name} is {age}, {{name}}"_atom;
+        str.ReplaceMany({ { L"{name}", L"{age}" }, { L"{age}", L"42" }, { L"{n", L"-" } });
+        EXPECT_EQ(L"{age} is 42, {{age}}", str);
+    }
 }
 
 TEST(StringTest, BaseString_wchar_t_default_Regex)
@@ -2198,4 +2796,404 @@ TEST(StringTest, BaseString_wchar_t_default__Erase)
         str.Erase(str.begin() + 5, str.begin() + 7);
         EXPECT_EQ(L"Hellorld!", str);
     }
-}
\ No newline at end of file
+}
+
+TEST(StringTest, BaseString_wchar_t_default__CompileTimeLiteral)
+{
+    using Core::WStringAtom;
+
+    constexpr auto hash = Core::_StringHasher<wchar_t>::Hash(L"Hello world, compile time!", 26);
+    const std::wstring runtimeString = L"Hello world, compile time!";
+    EXPECT_EQ(hash, Core::_StringHasher<wchar_t>::Hash(runtimeString.data(), runtimeString.size()));
+
+    const auto charsCount = Core::_StringPool<wchar_t>::Instance().GetStatistics().charsCount;
+    const auto str1 = L"StringTest.CompileTimeLiteral.NotCopied"_atom;
+    const auto str2 = L"StringTest.CompileTimeLiteral.NotCopied"_atom;
+    EXPECT_EQ(charsCount, Core::_StringPool<wchar_t>::Instance().GetStatistics().charsCount);
+    EXPECT_TRUE(str1.IsStatic());
+    EXPECT_EQ(str1.c_str(), str2.c_str());
+    EXPECT_EQ(str1.c_str(), WStringAtom::Intern(std::wstring(L"StringTest.CompileTimeLiteral.NotCopied")).c_str());
+    EXPECT_EQ(L"StringTest.CompileTimeLiteral.NotCopied", str1);
+}
+
+TEST(StringTest, BaseString_wchar_t_default__Hash)
+{
+    using Core::WStringAtom;
+
+    const auto atom = L"StringTest.Hash"_atom;
+    const WStringAtom dynamic = L"StringTest.Hash";
+    EXPECT_EQ(Core::_StringHasher<wchar_t>::Hash(L"StringTest.Hash", 15), atom.MakeHash());
+    EXPECT_EQ(atom.MakeHash(), dynamic.MakeHash());
+    EXPECT_EQ(atom.MakeHash(), std::hash<WStringAtom>{}(dynamic));
+
+    WStringAtom modified = dynamic;
+    modified.PushBack(L'!');
+    EXPECT_EQ(Core::_StringHasher<wchar_t>::Hash(L"StringTest.Hash!", 16), modified.MakeHash());
+    modified.PopBack();
+    EXPECT_EQ(atom.MakeHash(), modified.MakeHash());
+    modified.ToUpperCase();
+    EXPECT_EQ(Core::_StringHasher<wchar_t>::Hash(L"STRINGTEST.HASH", 15), modified.MakeHash());
+    modified = atom;
+    EXPECT_EQ(atom.MakeHash(), modified.MakeHash());
+}
+
+TEST(StringTest, BaseString_wchar_t_default__SmallStringOptimization)
+{
+    using Core::WStringAtom;
+
+    const std::wstring shortString(WStringAtom::inlineCapacity - 1, L'a');
+    const std::wstring longString(WStringAtom::inlineCapacity, L'b');
+
+    WStringAtom str = shortString.c_str();
+    EXPECT_TRUE(str.IsInline());
+    EXPECT_EQ(WStringAtom::inlineCapacity, str.Capacity());
+    EXPECT_EQ(shortString, str.c_str());
+
+    WStringAtom copy = str;
+    EXPECT_TRUE(copy.IsInline());
+    EXPECT_EQ(str, copy);
+
+    WStringAtom moved = std::move(copy);
+    EXPECT_TRUE(moved.IsInline());
+    EXPECT_EQ(shortString, moved.c_str());
+
+    str.PushBack(L'b');
+    EXPECT_FALSE(str.IsInline());
+    EXPECT_EQ(shortString + L"b", str.c_str());
+    str.Reserve(1);
+    EXPECT_TRUE(str.IsInline());
+    EXPECT_EQ(L"a", str);
+
+    EXPECT_FALSE(WStringAtom(longString.c_str()).IsInline());
+    EXPECT_FALSE(WStringAtom::Intern(shortString).IsInline());
+
+    auto atom = WStringAtom::Intern(shortString);
+    atom.PushBack(L'c');
+    EXPECT_EQ(shortString + L"c", atom.c_str());
+    atom.PopBack();
+    atom.PopBack();
+    atom.Reserve(atom.Size());
+    EXPECT_TRUE(atom.IsInline());
+    EXPECT_EQ(shortString.substr(1), atom.c_str());
+}
+
+TEST(StringTest, BaseString_wchar_t_default__MemoryResource)
+{
+    using Core::WStringAtom;
+
+    const std::wstring longString(WStringAtom::inlineCapacity * 4, L'a');
+    CountingMemoryResource resource;
+    {
+        WStringAtom str(longString, &resource);
+        EXPECT_EQ(&resource, str.GetMemoryResource());
+        EXPECT_EQ(1, resource.allocationsCount);
+
+        WStringAtom moved = std::move(str);
+        EXPECT_EQ(&resource, moved.GetMemoryResource());
+        EXPECT_EQ(1, resource.allocationsCount);
+
+        WStringAtom copy = moved;
+        EXPECT_EQ(nullptr, copy.GetMemoryResource());
+        EXPECT_EQ(1, resource.allocationsCount);
+
+        WStringAtom other(&resource);
+        other = std::move(copy);
+        EXPECT_EQ(2, resource.allocationsCount);
+        EXPECT_EQ(longString, other.c_str());
+
+        WStringAtom shortString(L"abc", &resource);
+        EXPECT_TRUE(shortString.IsInline());
+        EXPECT_EQ(2, resource.allocationsCount);
+    }
+    EXPECT_EQ(resource.allocationsCount, resource.deallocationsCount);
+
+    std::pmr::monotonic_buffer_resource arena;
+    WStringAtom str(&arena);
+    for (const auto ch : longString)
+    {
+        str.PushBack(ch);
+    }
+    EXPECT_EQ(longString, str.c_str());
+}
+
+TEST(StringTest, BaseString_wchar_t_default__Append)
+{
+    using Core::WStringAtom;
+
+    WStringAtom str;
+    for (int i = 0; i < 100; ++i)
+    {
+        str.PushBack(L'a');
+        EXPECT_LT(str.Size(), str.Capacity());
+        EXPECT_EQ(0, str.c_str()[str.Size()]);
+    }
+    EXPECT_EQ(std::wstring(100, L'a'), str.c_str());
+
+    // the appended characters are a part of the string which is reallocated
+    str = WStringAtom(L"abcdefghijklmnopqrstuvwxyz");
+    str.ShrinkToFit();
+    str += str.ToStringView();
+    EXPECT_EQ(L"abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz", str);
+
+    const auto capacity = str.Capacity();
+    str.Resize(4);
+    str.Resize(6);
+    EXPECT_EQ(capacity, str.Capacity());
+    EXPECT_EQ(6, str.Size());
+    EXPECT_EQ(0, str[4]);
+    EXPECT_EQ(0, str[5]);
+    EXPECT_EQ(0, str.c_str()[6]);
+
+    auto atom = WStringAtom::Intern(L"STRINGTEST.APPEND");
+    atom += L"";
+    EXPECT_TRUE(atom.IsStatic());
+    atom += L"!";
+    EXPECT_TRUE(atom.IsDynamic());
+    EXPECT_EQ(L"STRINGTEST.APPEND!", atom);
+    EXPECT_EQ(L"STRINGTEST.APPEND", WStringAtom::Intern(L"STRINGTEST.APPEND"));
+}
+
+TEST(StringTest, BaseString_wchar_t_default__StrCat)
+{
+    using Core::WStringAtom;
+
+    const auto atom = WStringAtom::Intern(L"key");
+    const WStringAtom dynamic = L"value";
+    const std::wstring stdString = L"std";
+    const auto str = Core::StrCat(atom, L'=', dynamic, L" ", stdString, L' ', 42, L' ', -7ll, L' ', 0.5);
+    EXPECT_TRUE((std::is_same_v<std::remove_cvref_t<decltype(str)>, WStringAtom>));
+    EXPECT_EQ(L"key=value std 42 -7 0.5", str);
+    EXPECT_EQ(str.Size() + 1, str.Capacity());
+
+    EXPECT_TRUE(Core::StrCat<wchar_t>().IsEmpty());
+    EXPECT_EQ(L"1x", Core::StrCat<wchar_t>(1, 'x'));
+
+    const std::vector<WStringAtom> words = { L"one", L"two", L"three" };
+    EXPECT_EQ(L"one, two, three", Core::Join(words, L", "));
+    EXPECT_EQ(L"1-2-3", Core::Join<wchar_t>(std::vector<int>{ 1, 2, 3 }, L'-'));
+    EXPECT_TRUE(Core::Join(std::vector<WStringAtom>{}, L", ").IsEmpty());
+
+    WStringAtom erased = L"Hello World";
+    erased.Erase(5);
+    EXPECT_EQ(L"HelloWorld", erased);
+}
+
+TEST(StringTest, BaseString_wchar_t_default__CopyOnWrite)
+{
+    using Core::WStringAtom;
+
+    const WStringAtom original = L"A string which doesn't fit the inline buffer";
+    const std::wstring_view text = original.ToStringView();
+
+    {
+        WStringAtom copy = original;
+        copy.PushBack(L'!');
+        copy.Data()[0] = L'a';
+        EXPECT_EQ(text, original.ToStringView());
+        EXPECT_EQ(L"a string which doesn't fit the inline buffer!", copy);
+    }
+
+    {
+        WStringAtom copy = original;
+        copy.ToUpperCase();
+        EXPECT_EQ(text, original.ToStringView());
+        EXPECT_EQ(L"A STRING WHICH DOESN'T FIT THE INLINE BUFFER", copy);
+    }
+
+    {
+        WStringAtom copy = original;
+        copy.TrimEnd(L'r');
+        copy.PushFront(L"> ");
+        copy.Insert(0, L"<");
+        EXPECT_EQ(text, original.ToStringView());
+        EXPECT_EQ(L"<> A string which doesn't fit the inline buffe", copy);
+    }
+
+    {
+        WStringAtom copy = original;
+        copy = std::wstring_view(L"Another string which doesn't fit the inline buffer");
+        copy.PopBack();
+        EXPECT_EQ(text, original.ToStringView());
+        EXPECT_EQ(L"Another string which doesn't fit the inline buffe", copy);
+    }
+
+    {
+        // the buffer of a grown string has room for the appended characters
+        WStringAtom grown;
+        for (const auto ch : std::wstring_view(L"twenty characters..."))
+        {
+            grown.PushBack(ch);
+        }
+        ASSERT_GT(grown.Capacity(), grown.Size() + 2);
+
+        WStringAtom pushedChar = grown;
+        pushedChar.PushBack(L'Y');
+        EXPECT_EQ(21, pushedChar.Size());
+        EXPECT_EQ(L"twenty characters...Y", pushedChar.ToStringView());
+
+        WStringAtom pushedView = grown;
+        pushedView.PushBack(L"ZZ");
+        EXPECT_EQ(22, pushedView.Size());
+        EXPECT_EQ(L"twenty characters...ZZ", pushedView.ToStringView());
+
+        WStringAtom pushedFront = grown;
+        pushedFront.PushFront(L'P');
+        EXPECT_EQ(21, pushedFront.Size());
+        EXPECT_EQ(L"Ptwenty characters...", pushedFront.ToStringView());
+
+        WStringAtom inserted = grown;
+        inserted.Insert(0, L"Q");
+        EXPECT_EQ(21, inserted.Size());
+        EXPECT_EQ(L"Qtwenty characters...", inserted.ToStringView());
+
+        EXPECT_EQ(L"twenty characters...", grown.ToStringView());
+    }
+
+    {
+        // the characters written through the pointer given out by Data() don't get into the later copies
+        WStringAtom leaked = original;
+        auto* characters = leaked.Data();
+        const WStringAtom copy = leaked;
+        characters[0] = L'X';
+        EXPECT_EQ(L'X', leaked[0]);
+        EXPECT_EQ(L'A', copy[0]);
+        EXPECT_EQ(text, original.ToStringView());
+
+        WStringAtom moved = std::move(leaked);
+        const WStringAtom movedCopy = moved;
+        characters[1] = L'Y';
+        EXPECT_EQ(L'Y', moved[1]);
+        EXPECT_EQ(L' ', movedCopy[1]);
+    }
+
+#ifdef CORE_STRING_COPY_ON_WRITE
+    {
+        WStringAtom copy = original;
+        EXPECT_TRUE(copy.IsBufferShared());
+        EXPECT_TRUE(original.IsBufferShared());
+        EXPECT_EQ(original.c_str(), copy.c_str());
+
+        copy.PushBack(L'!');
+        EXPECT_FALSE(copy.IsBufferShared());
+        EXPECT_FALSE(original.IsBufferShared());
+        EXPECT_NE(original.c_str(), copy.c_str());
+    }
+
+    CountingMemoryResource resource;
+    {
+        const WStringAtom source(text, &resource);
+        WStringAtom copy(&resource);
+        copy = source;
+        EXPECT_TRUE(copy.IsBufferShared());
+        EXPECT_EQ(1, resource.allocationsCount);
+
+        // a copy which uses another resource never refers to the buffer
+        const WStringAtom heapCopy = source;
+        EXPECT_FALSE(heapCopy.IsBufferShared());
+    }
+    EXPECT_EQ(1, resource.deallocationsCount);
+#endif
+}
+
+TEST(StringTest, BaseString_wchar_t_default__FindLong)
+{
+    using Core::WStringAtom;
+
+    // sizes around the vector width, needles at the edges and embedded zeros
+    std::mt19937 random(7);
+    for (std::size_t size = 1; size < 200; ++size)
+    {
+        std::wstring text(size, L'a');
+        for (auto& ch : text)
+        {
+            ch = static_cast<wchar_t>(random() % 3 == 0 ? 0 : L'a' + random() % 3);
+        }
+        const WStringAtom str{std::wstring_view(text)};
+
+        for (std::size_t needleSize = 1; needleSize <= std::min<std::size_t>(size, 6); ++needleSize)
+        {
+            const std::wstring needle = text.substr(random() % (size - needleSize + 1), needleSize);
+
+            std::vector<std::size_t> expected;
+            for (auto offset = text.find(needle); offset != std::wstring::npos; offset = text.find(needle, offset + 1))
+            {
+                expected.push_back(offset);
+            }
+
+            ASSERT_EQ(expected, str.FindAllOffsets(needle));
+            ASSERT_EQ(str.c_str() + expected.front(), str.Find(needle));
+        }
+    }
+
+    const WStringAtom str = L"aaaa";
+    EXPECT_EQ((std::vector<std::size_t>{ 0, 1, 2 }), str.FindAllOffsets(L"aa"));
+    EXPECT_EQ(nullptr, str.Find(L"aaaaa"));
+    EXPECT_EQ(str.c_str() + 3, str.Find(L"a", 3));
+    EXPECT_EQ(nullptr, str.Find(L"a", 4));
+
+    const std::wstring haystack = std::wstring(1 << 16, L'x') + L"needle";
+    const WStringAtom big{std::wstring_view(haystack)};
+    EXPECT_EQ(big.c_str() + (1 << 16), big.Find(L"needle"));
+
+    int count = 0;
+    big.IterateFind(L"xx", [&count](std::size_t) { return ++count < 10; });
+    EXPECT_EQ(10, count);
+}
+
+TEST(StringTest, BaseString_wchar_t_default__CaseLong)
+{
+    using Core::WStringAtom;
+
+    const auto toUpper = [](wchar_t ch) { return static_cast<wchar_t>(std::towupper(static_cast<std::wint_t>(ch))); };
+    const auto toLower = [](wchar_t ch) { return static_cast<wchar_t>(std::towlower(static_cast<std::wint_t>(ch))); };
+    const auto compare = [&toUpper](std::wstring_view first, std::wstring_view second) {
+        for (std::size_t i = 0; i < std::min(first.size(), second.size()); ++i)
+        {
+            const auto ch = static_cast<std::make_unsigned_t<wchar_t>>(toUpper(first[i]));
+            const auto otherCh = static_cast<std::make_unsigned_t<wchar_t>>(toUpper(second[i]));
+            if (ch != otherCh)
+            {
+                return ch < otherCh ? Core::Comparison::Less : Core::Comparison::Greater;
+            }
+        }
+        if (first.size() == second.size())
+        {
+            return Core::Comparison::Equal;
+        }
+        return first.size() < second.size() ? Core::Comparison::Less : Core::Comparison::Greater;
+    };
+
+    // sizes around the vector width, the letters at the edges of the ranges, non-ASCII characters in some of the vectors
+    std::mt19937 random(11);
+    const std::wstring alphabet = L"aAzZ@[`{_09\u0416\u00E9";
+    for (std::size_t size = 1; size < 100; ++size)
+    {
+        const bool isAscii = random() % 2 == 0;
+        std::wstring text(size, L'a');
+        for (auto& ch : text)
+        {
+            ch = alphabet[random() % (isAscii ? alphabet.size() - 2 : alphabet.size())];
+        }
+
+        std::wstring upper = text;
+        std::wstring lower = text;
+        std::ranges::transform(upper, upper.begin(), toUpper);
+        std::ranges::transform(lower, lower.begin(), toLower);
+
+        auto str = WStringAtom{ std::wstring_view(text) };
+        str.ToUpperCase();
+        ASSERT_EQ(upper, str);
+        str.ToLowerCase();
+        ASSERT_EQ(lower, str);
+
+        const WStringAtom original{ std::wstring_view(text) };
+        ASSERT_TRUE(original.IsEqualIgnoreCase(upper));
+        ASSERT_EQ(Core::Comparison::Equal, original.Compare(lower, true));
+
+        std::wstring other = lower;
+        other[random() % size] = alphabet[random() % alphabet.size()];
+        ASSERT_EQ(compare(text, other), original.Compare(other, true));
+        ASSERT_EQ(compare(text, other) == Core::Comparison::Equal, original.IsEqualIgnoreCase(other));
+        ASSERT_EQ(Core::Comparison::Less, original.Compare(upper + L"a", true));
+    }
+}
@@ -0,0 +1,400 @@
+// MIT License
+//
+// Copyright (c) 2024 Valerii Koniushenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Core/StringView.h"
+
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+TEST(StringViewTest, BaseStringView_char_Creation)
+{
+    using Core::StringAtom;
+    using Core::StringAtomView;
+
+    {
+        const StringAtomView view;
+        EXPECT_TRUE(view.IsEmpty());
+        EXPECT_EQ(0, view.Size());
+    }
+
+    {
+        const StringAtom str = "Hello World!";
+        const StringAtomView view = str;
+        EXPECT_EQ(str.data(), view.data());
+        EXPECT_EQ(12, view.Size());
+        EXPECT_EQ('H', view.Front());
+        EXPECT_EQ('!', view.Back());
+        EXPECT_EQ('W', view[6]);
+        EXPECT_TRUE(view == "Hello World!");
+        EXPECT_TRUE(view == str);
+        EXPECT_TRUE(str == view);
+        EXPECT_TRUE(view == view);
+        EXPECT_EQ(str.MakeHash(), view.MakeHash());
+        EXPECT_EQ(str, view.ToString());
+    }
+
+    {
+        const StringAtomView view("Hello World!", 5);
+        EXPECT_TRUE(view == std::string_view("Hello"));
+        EXPECT_TRUE(view < "Hello World!");
+        EXPECT_TRUE(view > "Hella");
+    }
+}
+
+TEST(StringViewTest, BaseStringView_char_Find)
+{
+    using Core::StringAtomView;
+
+    const Core::StringAtom str = "one two one two";
+    const StringAtomView view = str;
+
+    EXPECT_EQ(str.data() + 4, view.Find("two"));
+    EXPECT_EQ(str.data() + 12, view.Find("two", 5));
+    EXPECT_EQ(nullptr, view.Find("three"));
+    EXPECT_EQ(2, view.FindAll("one").size());
+
+    // the slice doesn't see the characters after its end
+    const StringAtomView slice("one two", 5);
+    EXPECT_EQ(nullptr, slice.Find("two"));
+    EXPECT_TRUE(slice.StartsWith("one"));
+    EXPECT_TRUE(slice.EndsWith("t"));
+}
+
+TEST(StringViewTest, BaseStringView_char_Compare)
+{
+    using Core::Comparison;
+    using Core::StringAtomView;
+
+    const StringAtomView view = "Hello";
+    EXPECT_EQ(Comparison::Equal, view.Compare("Hello"));
+    EXPECT_EQ(Comparison::Less, view.Compare("Hello!"));
+    EXPECT_EQ(Comparison::Greater, view.Compare("Hell"));
+    EXPECT_EQ(Comparison::Less, view.Compare("Help"));
+    EXPECT_EQ(Comparison::Equal, view.Compare("hELLO", true));
+    EXPECT_EQ(Comparison::Greater, view.Compare("hELL", true));
+    EXPECT_EQ(Comparison::Less, view.Compare("hELP", true));
+    EXPECT_TRUE(view.IsEqualIgnoreCase("hELLO"));
+    EXPECT_FALSE(view.IsEqualIgnoreCase("hELL"));
+
+    // longer than a vector, the difference is after the first vectors
+    const auto text = "Content-Type: text/html; charset=UTF-8; boundary=something"_atom;
+    const auto lower = "content-type: TEXT/HTML; CHARSET=utf-8; boundary=somethinG"_atom;
+    EXPECT_TRUE(StringAtomView(text).IsEqualIgnoreCase(lower));
+    EXPECT_EQ(Comparison::Less, StringAtomView(text).Compare("content-type: text/html; charset=utf-8; boundary=somethinh", true));
+}
+
+TEST(StringViewTest, BaseStringView_char_Modifications)
+{
+    using Core::StringAtom;
+    using Core::StringAtomView;
+
+    const StringAtom str = "  Hello world!  ";
+    StringAtomView view = str;
+    view.Trim(' ');
+    EXPECT_TRUE(view == "Hello world!");
+    EXPECT_EQ(str.data() + 2, view.data());
+
+    StringAtomView copy = view;
+    copy.SubStr(6);
+    EXPECT_TRUE(copy == "world!");
+
+    copy = view;
+    copy.SubStr(2, 5);
+    EXPECT_TRUE(copy == "llo");
+
+    copy = "xxx";
+    copy.TrimStart('x');
+    EXPECT_TRUE(copy.IsEmpty());
+
+    // the original string isn't changed
+    EXPECT_EQ("  Hello world!  ", str);
+}
+
+TEST(StringViewTest, BaseStringView_char_Split)
+{
+    using Core::StringAtomView;
+
+    const StringAtomView view = "  key = value ;next";
+    const auto tokens = view.Split(" =;");
+    ASSERT_EQ(3, tokens.size());
+    EXPECT_TRUE(tokens[0] == "key");
+    EXPECT_TRUE(tokens[1] == "value");
+    EXPECT_TRUE(tokens[2] == "next");
+    EXPECT_EQ(view.data() + 2, tokens[0].data());
+
+    EXPECT_TRUE(StringAtomView(";;;").Split(";").empty());
+}
+
+TEST(StringViewTest, BaseStringView_char_Regex)
+{
+    using Core::StringAtomView;
+
+    const StringAtomView view("id=42; id=7", 11);
+    EXPECT_FALSE(view.RegexMatch("id=[0-9]+"));
+    EXPECT_TRUE(StringAtomView("id=42; id=7", 5).RegexMatch("id=[0-9]+"));
+
+    const auto match = view.FindRegex("[0-9]+");
+    ASSERT_FALSE(match.empty());
+    EXPECT_EQ("42", match.str());
+
+    int count = 0;
+    view.IterateRegex("id=([0-9]+)", [&count](const auto&) {
+        ++count;
+        return true;
+    });
+    EXPECT_EQ(2, count);
+}
+
+TEST(StringViewTest, BaseStringView_char_ConvertTo)
+{
+    using Core::StringAtomView;
+
+    // the characters after the slice aren't parsed
+    EXPECT_EQ(12, StringAtomView("12345", 2).ConvertTo<int>());
+    EXPECT_EQ(-1234567890123ll, StringAtomView("-1234567890123").ConvertTo<long long>());
+    EXPECT_DOUBLE_EQ(1.5, StringAtomView("1.5e3", 3).ConvertTo<double>());
+    EXPECT_FLOAT_EQ(2.25f, StringAtomView("2.25").ConvertTo<float>());
+}
+
+TEST(StringViewTest, SplitView_char_Split)
+{
+    using Core::StringAtom;
+    using Core::SplitDelimiter;
+    using Core::StringSplitView;
+
+    auto collect = [](const StringSplitView& split) {
+        std::vector<std::string_view> fields;
+        for (const auto field : split)
+        {
+            fields.push_back(field);
+        }
+        return fields;
+    };
+
+    const StringAtom str = "a,b;;c,";
+    EXPECT_EQ((std::vector<std::string_view>{ "a", "b", "c" }), collect(StringSplitView(str, ",;")));
+    EXPECT_EQ((std::vector<std::string_view>{ "a", "b", "", "c", "" }), collect(StringSplitView(str, ",;", SplitDelimiter::AnyOf, true)));
+    EXPECT_EQ((std::vector<std::string_view>{ "a,b", "c," }), collect(StringSplitView(str, ";;", SplitDelimiter::Exact)));
+    EXPECT_EQ((std::vector<std::string_view>{ "a,b;;c," }), collect(StringSplitView(str, ";,", SplitDelimiter::Exact)));
+
+    const StringAtom record = "key::value::::end::";
+    EXPECT_EQ((std::vector<std::string_view>{ "key", "value", "end" }), collect(StringSplitView(record, "::", SplitDelimiter::Exact)));
+    EXPECT_EQ((std::vector<std::string_view>{ "key", "value", "", "end", "" }),
+              collect(StringSplitView(record, "::", SplitDelimiter::Exact, true)));
+
+    EXPECT_TRUE(collect(StringSplitView("", ",", SplitDelimiter::AnyOf, true)).empty());
+    EXPECT_TRUE(collect(StringSplitView(",,,", ",")).empty());
+    EXPECT_EQ(4, std::ranges::distance(StringSplitView(",,,", ",", SplitDelimiter::AnyOf, true)));
+
+    // the fields point into the string
+    Core::SplitView split(str, ",");
+    EXPECT_EQ(str.data(), split.begin()->data());
+    EXPECT_EQ(str.data() + 2, std::next(split.begin())->data());
+}
+
+TEST(StringViewTest, BaseStringView_wchar_t_Creation)
+{
+    using Core::WStringAtom;
+    using Core::WStringAtomView;
+
+    {
+        const WStringAtomView view;
+        EXPECT_TRUE(view.IsEmpty());
+        EXPECT_EQ(0, view.Size());
+    }
+
+    {
+        const WStringAtom str = L"Hello World!";
+        const WStringAtomView view = str;
+        EXPECT_EQ(str.data(), view.data());
+        EXPECT_EQ(12, view.Size());
+        EXPECT_EQ(L'H', view.Front());
+        EXPECT_EQ(L'!', view.Back());
+        EXPECT_EQ(L'W', view[6]);
+        EXPECT_TRUE(view == L"Hello World!");
+        EXPECT_TRUE(view == str);
+        EXPECT_TRUE(str == view);
+        EXPECT_TRUE(view == view);
+        EXPECT_EQ(str.MakeHash(), view.MakeHash());
+        EXPECT_EQ(str, view.ToString());
+    }
+
+    {
+        const WStringAtomView view(L"Hello World!", 5);
+        EXPECT_TRUE(view == std::wstring_view(L"Hello"));
+        EXPECT_TRUE(view < L"Hello World!");
+        EXPECT_TRUE(view > L"Hella");
+    }
+}
+
+TEST(StringViewTest, BaseStringView_wchar_t_Find)
+{
+    using Core::WStringAtomView;
+
+    const Core::WStringAtom str = L"one two one two";
+    const WStringAtomView view = str;
+
+    EXPECT_EQ(str.data() + 4, view.Find(L"two"));
+    EXPECT_EQ(str.data() + 12, view.Find(L"two", 5));
+    EXPECT_EQ(nullptr, view.Find(L"three"));
+    EXPECT_EQ(2, view.FindAll(L"one").size());
+
+    // the slice doesn't see the characters after its end
+    const WStringAtomView slice(L"one two", 5);
+    EXPECT_EQ(nullptr, slice.Find(L"two"));
+    EXPECT_TRUE(slice.StartsWith(L"one"));
+    EXPECT_TRUE(slice.EndsWith(L"t"));
+}
+
+TEST(StringViewTest, BaseStringView_wchar_t_Compare)
+{
+    using Core::Comparison;
+    using Core::WStringAtomView;
+
+    const WStringAtomView view = L"Hello";
+    EXPECT_EQ(Comparison::Equal, view.Compare(L"Hello"));
+    EXPECT_EQ(Comparison::Less, view.Compare(L"Hello!"));
+    EXPECT_EQ(Comparison::Greater, view.Compare(L"Hell"));
+    EXPECT_EQ(Comparison::Less, view.Compare(L"Help"));
+    EXPECT_EQ(Comparison::Equal, view.Compare(L"hELLO", true));
+    EXPECT_EQ(Comparison::Greater, view.Compare(L"hELL", true));
+    EXPECT_EQ(Comparison::Less, view.Compare(L"hELP", true));
+    EXPECT_TRUE(view.IsEqualIgnoreCase(L"hELLO"));
+    EXPECT_FALSE(view.IsEqualIgnoreCase(L"hELL"));
+
+    // longer than a vector, the difference is after the first vectors
+    const auto text = L"Content-Type: text/html; charset=UTF-8; boundary=something"_atom;
+    const auto lower = L"content-type: TEXT/HTML; CHARSET=utf-8; boundary=somethinG"_atom;
+    EXPECT_TRUE(WStringAtomView(text).IsEqualIgnoreCase(lower));
+    EXPECT_EQ(Comparison::Less, WStringAtomView(text).Compare(L"content-type: text/html; charset=utf-8; boundary=somethinh", true));
+}
+
+TEST(StringViewTest, BaseStringView_wchar_t_Modifications)
+{
+    using Core::WStringAtom;
+    using Core::WStringAtomView;
+
+    const WStringAtom str = L"  Hello world!  ";
+    WStringAtomView view = str;
+    view.Trim(L' ');
+    EXPECT_TRUE(view == L"Hello world!");
+    EXPECT_EQ(str.data() + 2, view.data());
+
+    WStringAtomView copy = view;
+    copy.SubStr(6);
+    EXPECT_TRUE(copy == L"world!");
+
+    copy = view;
+    copy.SubStr(2, 5);
+    EXPECT_TRUE(copy == L"llo");
+
+    copy = L"xxx";
+    copy.TrimStart(L'x');
+    EXPECT_TRUE(copy.IsEmpty());
+
+    // the original string isn't changed
+    EXPECT_EQ(L"  Hello world!  ", str);
+}
+
+TEST(StringViewTest, BaseStringView_wchar_t_Split)
+{
+    using Core::WStringAtomView;
+
+    const WStringAtomView view = L"  key = value ;next";
+    const auto tokens = view.Split(L" =;");
+    ASSERT_EQ(3, tokens.size());
+    EXPECT_TRUE(tokens[0] == L"key");
+    EXPECT_TRUE(tokens[1] == L"value");
+    EXPECT_TRUE(tokens[2] == L"next");
+    EXPECT_EQ(view.data() + 2, tokens[0].data());
+
+    EXPECT_TRUE(WStringAtomView(L";;;").Split(L";").empty());
+}
+
+TEST(StringViewTest, BaseStringView_wchar_t_Regex)
+{
+    using Core::WStringAtomView;
+
+    const WStringAtomView view(L"id=42; id=7", 11);
+    EXPECT_FALSE(view.RegexMatch(L"id=[0-9]+"));
+    EXPECT_TRUE(WStringAtomView(L"id=42; id=7", 5).RegexMatch(L"id=[0-9]+"));
+
+    const auto match = view.FindRegex(L"[0-9]+");
+    ASSERT_FALSE(match.empty());
+    EXPECT_EQ(L"42", match.str());
+
+    int count = 0;
+    view.IterateRegex(L"id=([0-9]+)", [&count](const auto&) {
+        ++count;
+        return true;
+    });
+    EXPECT_EQ(2, count);
+}
+
+TEST(StringViewTest, BaseStringView_wchar_t_ConvertTo)
+{
+    using Core::WStringAtomView;
+
+    // the characters after the slice aren't parsed
+    EXPECT_EQ(12, WStringAtomView(L"12345", 2).ConvertTo<int>());
+    EXPECT_EQ(-1234567890123ll, WStringAtomView(L"-1234567890123").ConvertTo<long long>());
+    EXPECT_DOUBLE_EQ(1.5, WStringAtomView(L"1.5e3", 3).ConvertTo<double>());
+    EXPECT_FLOAT_EQ(2.25f, WStringAtomView(L"2.25").ConvertTo<float>());
+}
+
+TEST(StringViewTest, SplitView_wchar_t_Split)
+{
+    using Core::WStringAtom;
+    using Core::SplitDelimiter;
+    using Core::WStringSplitView;
+
+    auto collect = [](const WStringSplitView& split) {
+        std::vector<std::wstring_view> fields;
+        for (const auto field : split)
+        {
+            fields.push_back(field);
+        }
+        return fields;
+    };
+
+    const WStringAtom str = L"a,b;;c,";
+    EXPECT_EQ((std::vector<std::wstring_view>{ L"a", L"b", L"c" }), collect(WStringSplitView(str, L",;")));
+    EXPECT_EQ((std::vector<std::wstring_view>{ L"a", L"b", L"", L"c", L"" }), collect(WStringSplitView(str, L",;", SplitDelimiter::AnyOf, true)));
+    EXPECT_EQ((std::vector<std::wstring_view>{ L"a,b", L"c," }), collect(WStringSplitView(str, L";;", SplitDelimiter::Exact)));
+    EXPECT_EQ((std::vector<std::wstring_view>{ L"a,b;;c," }), collect(WStringSplitView(str, L";,", SplitDelimiter::Exact)));
+
+    const WStringAtom record = L"key::value::::end::";
+    EXPECT_EQ((std::vector<std::wstring_view>{ L"key", L"value", L"end" }), collect(WStringSplitView(record, L"::", SplitDelimiter::Exact)));
+    EXPECT_EQ((std::vector<std::wstring_view>{ L"key", L"value", L"", L"end", L"" }),
+              collect(WStringSplitView(record, L"::", SplitDelimiter::Exact, true)));
+
+    EXPECT_TRUE(collect(WStringSplitView(L"", L",", SplitDelimiter::AnyOf, true)).empty());
+    EXPECT_TRUE(collect(WStringSplitView(L",,,", L",")).empty());
+    EXPECT_EQ(4, std::ranges::distance(WStringSplitView(L",,,", L",", SplitDelimiter::AnyOf, true)));
+
+    // the fields point into the string
+    Core::SplitView split(str, L",");
+    EXPECT_EQ(str.data(), split.begin()->data());
+    EXPECT_EQ(str.data() + 2, std::next(split.begin())->data());
+}